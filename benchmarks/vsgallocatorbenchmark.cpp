@@ -0,0 +1,118 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/IntrusiveAllocator.h>
+#include <vsg/utils/CommandLine.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Measures small object allocation/deallocation throughput of IntrusiveAllocator from multiple threads,
+// with a proportion of the allocations freed by a different thread to the one that allocated them.
+// Each run is repeated with threadCacheSize = 0 to give the fully locked baseline.
+
+struct Exchange
+{
+    std::mutex mutex;
+    std::vector<std::pair<void*, size_t>> allocations;
+};
+
+double run(size_t threadCacheSize, size_t numThreads, size_t numIterations, size_t batchSize, double crossThreadRatio)
+{
+    vsg::IntrusiveAllocator allocator;
+    allocator.threadCacheSize = threadCacheSize;
+
+    std::vector<Exchange> exchanges(numThreads);
+
+    auto worker = [&](size_t threadIndex) {
+        std::mt19937 generator(static_cast<unsigned int>(threadIndex));
+        std::uniform_int_distribution<size_t> sizeDistribution(8, 256);
+
+        std::vector<std::pair<void*, size_t>> allocations;
+        std::vector<std::pair<void*, size_t>> received;
+        allocations.reserve(batchSize);
+
+        size_t numCrossThread = static_cast<size_t>(static_cast<double>(batchSize) * crossThreadRatio);
+        auto& outgoing = exchanges[(threadIndex + 1) % numThreads];
+        auto& incoming = exchanges[threadIndex];
+
+        for (size_t iteration = 0; iteration < numIterations; ++iteration)
+        {
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                size_t size = sizeDistribution(generator);
+                allocations.emplace_back(allocator.allocate(size, vsg::ALLOCATOR_AFFINITY_OBJECTS), size);
+            }
+
+            // pass the first numCrossThread allocations to the next thread to free
+            {
+                std::scoped_lock<std::mutex> lock(outgoing.mutex);
+                outgoing.allocations.insert(outgoing.allocations.end(), allocations.begin(), allocations.begin() + numCrossThread);
+            }
+
+            for (size_t i = numCrossThread; i < allocations.size(); ++i) allocator.deallocate(allocations[i].first, allocations[i].second);
+            allocations.clear();
+
+            {
+                std::scoped_lock<std::mutex> lock(incoming.mutex);
+                received.swap(incoming.allocations);
+            }
+
+            for (auto& [ptr, size] : received) allocator.deallocate(ptr, size);
+            received.clear();
+        }
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i) threads.emplace_back(worker, i);
+    for (auto& thread : threads) thread.join();
+
+    // free the allocations left in the exchanges after the last iteration
+    for (auto& exchange : exchanges)
+    {
+        for (auto& [ptr, size] : exchange.allocations) allocator.deallocate(ptr, size);
+    }
+
+    auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    return duration / static_cast<double>(numThreads * numIterations * batchSize);
+}
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto numThreads = arguments.value<size_t>(std::max(1u, std::thread::hardware_concurrency()), {"--threads", "-t"});
+    auto numIterations = arguments.value<size_t>(10000, {"--iterations", "-i"});
+    auto batchSize = arguments.value<size_t>(64, {"--batch", "-b"});
+    auto crossThreadRatio = arguments.value<double>(0.5, "--cross-thread");
+    auto threadCacheSize = arguments.value<size_t>(64, "--cache-size");
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+
+    std::cout << "threads = " << numThreads << ", iterations = " << numIterations << ", batch = " << batchSize << ", cross thread ratio = " << crossThreadRatio << std::endl;
+
+    for (size_t numThreadsUsed = 1; numThreadsUsed <= numThreads; numThreadsUsed *= 2)
+    {
+        double cached = run(threadCacheSize, numThreadsUsed, numIterations, batchSize, crossThreadRatio);
+        double locked = run(0, numThreadsUsed, numIterations, batchSize, crossThreadRatio);
+        std::cout << "    " << numThreadsUsed << " threads : threadCacheSize = " << threadCacheSize << " " << cached << "ns, threadCacheSize = 0 " << locked << "ns per allocate/deallocate, speedup " << (locked / cached) << std::endl;
+    }
+
+    return 0;
+}
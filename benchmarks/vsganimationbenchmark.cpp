@@ -0,0 +1,109 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/animation/Animation.h>
+#include <vsg/animation/AnimationManager.h>
+#include <vsg/animation/TransformSampler.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/ui/FrameStamp.h>
+#include <vsg/utils/CommandLine.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+// Measures keyframe sampling with and without a cursor as time advances monotonically, and the time AnimationManager::run()
+// takes to update many independent transform animations, serially or spread over --threads update threads.
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto numAnimations = arguments.value<size_t>(1000, {"--animations", "-a"});
+    auto numSamplers = arguments.value<size_t>(20, {"--samplers", "-s"});
+    auto numKeyframes = arguments.value<size_t>(200, {"--keyframes", "-k"});
+    auto numFrames = arguments.value<size_t>(500, {"--frames", "-f"});
+    auto numThreads = arguments.value<uint32_t>(4, {"--threads", "-t"});
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+    if (numKeyframes < 2) numKeyframes = 2;
+
+    double duration = 10.0;
+    double frameTime = 1.0 / 60.0;
+
+    auto keyframes = vsg::TransformKeyframes::create();
+    for (size_t k = 0; k < numKeyframes; ++k)
+    {
+        double t = duration * static_cast<double>(k) / static_cast<double>(numKeyframes - 1);
+        keyframes->add(t, vsg::dvec3(t, std::sin(t), 0.0), vsg::dquat(t, vsg::dvec3(0.0, 0.0, 1.0)), vsg::dvec3(1.0, 1.0, 1.0));
+    }
+
+    // keyframe sampling, binary search vs cursor
+    {
+        size_t numSamples = numAnimations * numSamplers;
+        vsg::dvec3 position;
+        double checksum = 0.0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            vsg::sample(std::fmod(static_cast<double>(i) * frameTime, duration), keyframes->positions, position);
+            checksum += position.x;
+        }
+        auto searchTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        size_t cursor = 0;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            vsg::sample(std::fmod(static_cast<double>(i) * frameTime, duration), keyframes->positions, position, cursor);
+            checksum -= position.x;
+        }
+        auto cursorTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "keyframes = " << numKeyframes << ", samples = " << numSamples << ", checksum = " << checksum << std::endl;
+        std::cout << "    binary search : " << (searchTime * 1000.0 / static_cast<double>(numSamples)) << "ns per sample" << std::endl;
+        std::cout << "    cursor        : " << (cursorTime * 1000.0 / static_cast<double>(numSamples)) << "ns per sample" << std::endl;
+    }
+
+    // AnimationManager updates, each animation drives its own transforms so they can be updated concurrently
+    auto runAnimations = [&](uint32_t threads) {
+        auto animationManager = vsg::AnimationManager::create();
+        animationManager->numUpdateThreads = threads;
+
+        for (size_t a = 0; a < numAnimations; ++a)
+        {
+            auto animation = vsg::Animation::create();
+            for (size_t s = 0; s < numSamplers; ++s)
+            {
+                auto sampler = vsg::TransformSampler::create();
+                sampler->keyframes = keyframes;
+                sampler->object = vsg::MatrixTransform::create();
+                animation->samplers.push_back(sampler);
+            }
+            animationManager->play(animation);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < numFrames; ++frame)
+        {
+            animationManager->run(vsg::FrameStamp::create(vsg::clock::now(), frame, static_cast<double>(frame) * frameTime));
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(numFrames);
+    };
+
+    std::cout << "animations = " << numAnimations << ", samplers per animation = " << numSamplers << ", frames = " << numFrames << std::endl;
+    std::cout << "    serial update         : " << runAnimations(1) << "ms per frame" << std::endl;
+    std::cout << "    " << numThreads << " thread update      : " << runAnimations(numThreads) << "ms per frame" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/BatchCullGroup.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/utils/CommandLine.h>
+#include <vsg/vk/State.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Measures the cost per child of view frustum culling the children of a BatchCullGroup with BatchCullGroup::intersect(),
+// compared to testing each child's bound in double precision as done for CullNode, and checks that the batched float
+// test never culls a child that the double test finds visible, including for groups placed far from the world origin.
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto numChildren = arguments.value<size_t>(100000, {"--children", "-n"});
+    auto numFrames = arguments.value<size_t>(100, {"--frames", "-f"});
+    auto spacing = arguments.value<double>(10.0, "--spacing");
+    auto offset = arguments.value<double>(6.4e6, "--offset");
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+
+    // lay out the children on a square grid centered at (offset, 0, 0) with random radii
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> radiusDistribution(0.1, 1.0);
+
+    auto group = vsg::BatchCullGroup::create();
+    size_t gridSize = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(numChildren))));
+    double halfExtent = static_cast<double>(gridSize) * spacing * 0.5;
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+        vsg::dvec3 center(offset, static_cast<double>(i % gridSize) * spacing - halfExtent, static_cast<double>(i / gridSize) * spacing - halfExtent);
+        group->addChild(vsg::dsphere(center, spacing * radiusDistribution(generator)), vsg::Group::create());
+    }
+
+    // a child without a valid bound must never be culled
+    group->addChild(vsg::dsphere(), vsg::Group::create());
+
+    // camera looking along the x axis at the grid, rotating about it each frame so the frustum planes cut through the grid
+    auto projection = vsg::perspective(vsg::radians(60.0), 1.5, 1.0, halfExtent * 4.0);
+
+    double batchedTime = 0.0;
+    double individualTime = 0.0;
+    size_t numBatchedVisible = 0;
+    size_t numIndividualVisible = 0;
+    size_t numIncorrectlyCulled = 0;
+
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        double angle = 2.0 * vsg::PI * static_cast<double>(frame) / static_cast<double>(numFrames);
+        vsg::dvec3 eye(offset + halfExtent, halfExtent * 0.5 * std::cos(angle), halfExtent * 0.5 * std::sin(angle));
+        auto view = vsg::lookAt(eye, vsg::dvec3(offset, 0.0, 0.0), vsg::dvec3(0.0, 0.0, 1.0));
+        vsg::Frustum frustum(vsg::Frustum(), projection * view);
+
+        std::vector<uint64_t> masks((group->children.size() + 63) / 64);
+
+        auto startBatched = std::chrono::steady_clock::now();
+        for (size_t firstChild = 0; firstChild < group->children.size(); firstChild += 64)
+        {
+            masks[firstChild / 64] = group->intersect(frustum.face, vsg::POLYTOPE_SIZE, firstChild);
+        }
+        auto startIndividual = std::chrono::steady_clock::now();
+
+        std::vector<bool> visible(group->children.size());
+        for (size_t i = 0; i < group->children.size(); ++i)
+        {
+            const auto& bound = group->children[i].bound;
+            visible[i] = !bound.valid() || frustum.intersect(bound);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        batchedTime += std::chrono::duration<double, std::nano>(startIndividual - startBatched).count();
+        individualTime += std::chrono::duration<double, std::nano>(end - startIndividual).count();
+
+        for (size_t i = 0; i < group->children.size(); ++i)
+        {
+            bool batchedVisible = (masks[i / 64] & (uint64_t(1) << (i % 64))) != 0;
+            if (batchedVisible) ++numBatchedVisible;
+            if (visible[i]) ++numIndividualVisible;
+            if (visible[i] && !batchedVisible) ++numIncorrectlyCulled;
+        }
+    }
+
+    double numTests = static_cast<double>(group->children.size() * numFrames);
+    std::cout << "children = " << group->children.size() << ", frames = " << numFrames << ", offset = " << offset << std::endl;
+    std::cout << "    BatchCullGroup::intersect() " << (batchedTime / numTests) << "ns per child, " << numBatchedVisible << " visible" << std::endl;
+    std::cout << "    Frustum::intersect() " << (individualTime / numTests) << "ns per child, " << numIndividualVisible << " visible" << std::endl;
+    std::cout << "    speedup " << (individualTime / batchedTime) << ", incorrectly culled " << numIncorrectlyCulled << std::endl;
+
+    return numIncorrectlyCulled == 0 ? 0 : 1;
+}
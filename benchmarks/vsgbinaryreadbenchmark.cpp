@@ -0,0 +1,85 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/io/Options.h>
+#include <vsg/io/VSG.h>
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/utils/CommandLine.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+// Measures reading a .vsgb scene graph made up of many small objects, written with and without the class name table, where the
+// per object cost of reading and looking up class names dominates over the bulk copying of array data.
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto numTransforms = arguments.value<size_t>(20000, {"--transforms", "-n"});
+    auto numVertices = arguments.value<size_t>(4, {"--vertices", "-v"});
+    auto numReads = arguments.value<size_t>(10, {"--reads", "-r"});
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+
+    // scene graph of many small subgraphs, each with a handful of distinct object types
+    auto scene = vsg::Group::create();
+    for (size_t i = 0; i < numTransforms; ++i)
+    {
+        auto transform = vsg::MatrixTransform::create(vsg::translate(static_cast<double>(i), 0.0, 0.0));
+
+        auto vid = vsg::VertexIndexDraw::create();
+        vid->assignArrays(vsg::DataList{vsg::vec3Array::create(numVertices), vsg::vec2Array::create(numVertices)});
+        vid->assignIndices(vsg::ushortArray::create(numVertices));
+        vid->indexCount = static_cast<uint32_t>(numVertices);
+        vid->instanceCount = 1;
+
+        transform->addChild(vid);
+        scene->addChild(transform);
+    }
+
+    auto readerWriter = vsg::VSG::create();
+
+    auto run = [&](bool classTable) {
+        auto options = vsg::Options::create();
+        options->extensionHint = ".vsgb";
+        options->setValue(vsg::VSG::class_table, classTable);
+
+        std::ostringstream fout;
+        readerWriter->write(scene, fout, options);
+        std::string buffer = fout.str();
+
+        double time = 0.0;
+        for (size_t i = 0; i < numReads; ++i)
+        {
+            std::istringstream fin(buffer);
+            auto start = std::chrono::steady_clock::now();
+            auto object = readerWriter->read(fin, options);
+            time += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            if (!object) std::cerr << "Failed to read scene graph." << std::endl;
+        }
+
+        std::cout << "    " << (classTable ? "class table  : " : "class names  : ") << buffer.size() << " bytes, " << (time / static_cast<double>(numReads)) << "ms per read" << std::endl;
+    };
+
+    std::cout << "transforms = " << numTransforms << ", vertices = " << numVertices << ", reads = " << numReads << std::endl;
+    run(false);
+    run(true);
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/nodes/Bin.h>
+#include <vsg/utils/CommandLine.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Measures the per frame cost of sorting a depth sorted Bin, comparing the std::sort used previously with the radix sort, and
+// the radix sort with Bin::reuseSortOrder enabled, while the depths drift slightly from frame to frame as they do with a moving camera.
+
+class SortBin : public vsg::Inherit<vsg::Bin, SortBin>
+{
+public:
+    void assign(const std::vector<float>& depths)
+    {
+        _binElements.clear();
+        for (size_t i = 0; i < depths.size(); ++i) _binElements.emplace_back(depths[i], static_cast<uint32_t>(i));
+    }
+
+    void sort() const { _sort(); }
+
+    void stdSort() const
+    {
+        if (sortOrder == ASCENDING)
+            std::sort(_binElements.begin(), _binElements.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return lhs.first < rhs.first; });
+        else
+            std::sort(_binElements.begin(), _binElements.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return rhs.first < lhs.first; });
+    }
+};
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto numElements = arguments.value<size_t>(10000, {"--elements", "-n"});
+    auto numFrames = arguments.value<size_t>(1000, {"--frames", "-f"});
+    auto jitter = arguments.value<float>(0.001f, {"--jitter", "-j"});
+    auto descending = arguments.read("--descending");
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> depthDistribution(1.0f, 1000.0f);
+    std::uniform_real_distribution<float> jitterDistribution(-jitter, jitter);
+
+    std::vector<float> initialDepths(numElements);
+    for (auto& depth : initialDepths) depth = depthDistribution(generator);
+
+    // precompute the depths of every frame so each method sorts the same sequence
+    std::vector<std::vector<float>> frameDepths(numFrames, initialDepths);
+    for (size_t frame = 1; frame < numFrames; ++frame)
+    {
+        frameDepths[frame] = frameDepths[frame - 1];
+        for (auto& depth : frameDepths[frame]) depth *= 1.0f + jitterDistribution(generator);
+    }
+
+    auto run = [&](bool useStdSort, bool reuseSortOrder) {
+        auto bin = SortBin::create();
+        bin->sortOrder = descending ? vsg::Bin::DESCENDING : vsg::Bin::ASCENDING;
+        bin->reuseSortOrder = reuseSortOrder;
+
+        double time = 0.0;
+        for (auto& depths : frameDepths)
+        {
+            bin->assign(depths);
+            auto start = std::chrono::steady_clock::now();
+            if (useStdSort)
+                bin->stdSort();
+            else
+                bin->sort();
+            time += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+        return time / static_cast<double>(numFrames);
+    };
+
+    std::cout << "elements = " << numElements << ", frames = " << numFrames << ", jitter = " << jitter << (descending ? ", descending" : ", ascending") << std::endl;
+    std::cout << "    std::sort            : " << run(true, false) << "us per frame" << std::endl;
+    std::cout << "    radix sort           : " << run(false, false) << "us per frame" << std::endl;
+    std::cout << "    radix sort + reuse   : " << run(false, true) << "us per frame" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/maths/vec4.h>
+#include <vsg/utils/CommandLine.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Measures the CPU side cost and bytes copied per frame when a few elements of a large array are modified each frame, comparing
+// the tracking of dirty byte ranges with Data::dirty(begin, end) and copying just those ranges into a staging buffer, as done by
+// TransferTask, with marking the whole array dirty and copying all of it.
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto numElements = arguments.value<size_t>(1000000, {"--elements", "-n"});
+    auto numModified = arguments.value<size_t>(100, {"--modified", "-m"});
+    auto numFrames = arguments.value<size_t>(1000, {"--frames", "-f"});
+    auto clustered = arguments.read("--clustered");
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+
+    auto array = vsg::vec4Array::create(numElements);
+    std::vector<uint8_t> staging(array->dataSize());
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<size_t> indexDistribution(0, numElements - 1);
+
+    auto modify = [&](bool trackRanges) {
+        size_t start = indexDistribution(generator);
+        for (size_t i = 0; i < numModified; ++i)
+        {
+            size_t index = clustered ? (start + i) % numElements : indexDistribution(generator);
+            array->at(index).set(1.0f, 2.0f, 3.0f, static_cast<float>(i));
+            if (trackRanges) array->dirty(index * sizeof(vsg::vec4), (index + 1) * sizeof(vsg::vec4));
+        }
+        if (!trackRanges) array->dirty();
+    };
+
+    // dirty ranges
+    vsg::ModifiedCount copiedModifiedCount;
+    array->getModifiedCount(copiedModifiedCount);
+
+    std::vector<vsg::DirtyRange> dirtyRanges;
+    size_t rangesBytesCopied = 0;
+    size_t numRanges = 0;
+    auto startRanges = std::chrono::steady_clock::now();
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        modify(true);
+
+        dirtyRanges.clear();
+        auto data = static_cast<const uint8_t*>(array->dataPointer());
+        if (array->getDirtyRanges(copiedModifiedCount, dirtyRanges))
+        {
+            for (auto& range : dirtyRanges)
+            {
+                std::memcpy(staging.data() + range.begin, data + range.begin, range.end - range.begin);
+                rangesBytesCopied += range.end - range.begin;
+            }
+            numRanges += dirtyRanges.size();
+        }
+        else
+        {
+            std::memcpy(staging.data(), data, array->dataSize());
+            rangesBytesCopied += array->dataSize();
+        }
+
+        array->getModifiedCount(copiedModifiedCount);
+        array->pruneDirtyRanges(copiedModifiedCount);
+    }
+    auto rangesTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startRanges).count();
+
+    // whole array
+    size_t wholeBytesCopied = 0;
+    auto startWhole = std::chrono::steady_clock::now();
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        modify(false);
+
+        if (array->getModifiedCount(copiedModifiedCount))
+        {
+            std::memcpy(staging.data(), array->dataPointer(), array->dataSize());
+            wholeBytesCopied += array->dataSize();
+        }
+    }
+    auto wholeTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startWhole).count();
+
+    double frames = static_cast<double>(numFrames);
+    std::cout << "elements = " << numElements << " (" << array->dataSize() << " bytes), modified per frame = " << numModified << (clustered ? " clustered" : " scattered") << std::endl;
+    std::cout << "    dirty ranges : " << (rangesTime / frames) << "us, " << (static_cast<double>(rangesBytesCopied) / frames) << " bytes, " << (static_cast<double>(numRanges) / frames) << " copy regions per frame" << std::endl;
+    std::cout << "    whole array  : " << (wholeTime / frames) << "us, " << (static_cast<double>(wholeBytesCopied) / frames) << " bytes per frame" << std::endl;
+
+    return 0;
+}
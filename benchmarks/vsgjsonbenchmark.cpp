@@ -0,0 +1,95 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/JSONParser.h>
+#include <vsg/utils/CommandLine.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+// Measures parsing a JSON array of numbers, as found in glTF style documents, comparing numbers read through the original istream
+// based Schema::read_number() with the std::from_chars based ValuesSchema and the pre-sized JSONParser::read_values().
+
+// schema that only implements the istream read_number(), as schemas written before the std::string_view variant was added do
+struct StreamValuesSchema : public vsg::Inherit<vsg::JSONParser::Schema, StreamValuesSchema>
+{
+    std::vector<float> values;
+    void read_number(vsg::JSONParser&, std::istream& input) override
+    {
+        float value = 0.0f;
+        input >> value;
+        values.push_back(value);
+    }
+};
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto numValues = arguments.value<size_t>(1000000, {"--values", "-n"});
+    auto numParses = arguments.value<size_t>(5, {"--parses", "-p"});
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+
+    std::ostringstream json;
+    json << "[";
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        if (i > 0) json << ", ";
+        json << distribution(generator);
+    }
+    json << "]";
+
+    vsg::JSONParser parser;
+    parser.buffer = json.str();
+
+    auto time = [&](auto func) {
+        double total = 0.0;
+        for (size_t i = 0; i < numParses; ++i)
+        {
+            parser.pos = 0;
+            parser.warnings.clear();
+            auto start = std::chrono::steady_clock::now();
+            func();
+            total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (!parser.warnings.empty()) std::cerr << "Parsing produced " << parser.warnings.size() << " warnings." << std::endl;
+        return total / static_cast<double>(numParses);
+    };
+
+    auto streamTime = time([&]() {
+        StreamValuesSchema schema;
+        parser.read_array(schema);
+    });
+
+    auto valuesTime = time([&]() {
+        vsg::ValuesSchema<float> schema;
+        parser.read_array(schema);
+    });
+
+    auto readValuesTime = time([&]() {
+        parser.read_values<float>();
+    });
+
+    double megabytes = static_cast<double>(parser.buffer.size()) / (1024.0 * 1024.0);
+    std::cout << "values = " << numValues << ", " << megabytes << "MB" << std::endl;
+    std::cout << "    istream read_number       : " << streamTime << "ms, " << (megabytes * 1000.0 / streamTime) << "MB/s" << std::endl;
+    std::cout << "    ValuesSchema<float>       : " << valuesTime << "ms, " << (megabytes * 1000.0 / valuesTime) << "MB/s" << std::endl;
+    std::cout << "    read_values<float>()      : " << readValuesTime << "ms, " << (megabytes * 1000.0 / readValuesTime) << "MB/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/maths/vec3.h>
+#include <vsg/state/Sampler.h>
+#include <vsg/utils/CommandLine.h>
+#include <vsg/utils/SharedObjects.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Measures the cost of SharedObjects::share() for a mix of vertex arrays and samplers, where each distinct object is shared
+// several times as happens when loading models that reuse the same state, optionally from multiple threads to exercise the
+// sharded locking.
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto numDistinct = arguments.value<size_t>(10000, {"--distinct", "-d"});
+    auto numRepeats = arguments.value<size_t>(4, {"--repeats", "-r"});
+    auto numVertices = arguments.value<size_t>(64, {"--vertices", "-v"});
+    auto numThreads = arguments.value<size_t>(1, {"--threads", "-t"});
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+    if (numThreads == 0) numThreads = 1;
+
+    auto sharedObjects = vsg::SharedObjects::create();
+
+    // each thread creates and shares its own copies of the same distinct objects, so later shares find the existing instance
+    auto shareObjects = [&](size_t threadIndex) {
+        for (size_t repeat = threadIndex; repeat < numRepeats; repeat += numThreads)
+        {
+            for (size_t i = 0; i < numDistinct; ++i)
+            {
+                auto vertices = vsg::vec3Array::create(numVertices);
+                for (size_t v = 0; v < numVertices; ++v) vertices->at(v).set(static_cast<float>(i), static_cast<float>(v), 0.0f);
+                sharedObjects->share(vertices);
+
+                auto sampler = vsg::Sampler::create();
+                sampler->maxLod = static_cast<float>(i % 256);
+                sharedObjects->share(sampler);
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    if (numThreads == 1)
+    {
+        shareObjects(0);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < numThreads; ++t) threads.emplace_back(shareObjects, t);
+        for (auto& thread : threads) thread.join();
+    }
+    auto time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t numShares = numDistinct * numRepeats * 2;
+    std::cout << "distinct objects = " << numDistinct << ", repeats = " << numRepeats << ", vertices = " << numVertices << ", threads = " << numThreads << std::endl;
+    std::cout << "    " << numShares << " shares in " << time << "ms, " << (time * 1000.0 / static_cast<double>(numShares)) << "us per share" << std::endl;
+
+    return 0;
+}
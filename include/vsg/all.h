@@ -25,6 +25,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/External.h>
 #include <vsg/core/Inherit.h>
 #include <vsg/core/IntrusiveAllocator.h>
+#include <vsg/core/MappedData.h>
 #include <vsg/core/Mask.h>
 #include <vsg/core/MemorySlots.h>
 #include <vsg/core/MipmapLayout.h>
@@ -61,6 +62,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 // Node header files
 #include <vsg/nodes/AbsoluteTransform.h>
+#include <vsg/nodes/BatchCullGroup.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/nodes/Compilable.h>
 #include <vsg/nodes/CoordinateFrame.h>
@@ -69,6 +71,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/DepthSorted.h>
 #include <vsg/nodes/Geometry.h>
 #include <vsg/nodes/Group.h>
+#include <vsg/nodes/InstanceCulling.h>
 #include <vsg/nodes/InstanceDraw.h>
 #include <vsg/nodes/InstanceDrawIndexed.h>
 #include <vsg/nodes/InstanceNode.h>
@@ -77,6 +80,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/Layer.h>
 #include <vsg/nodes/MatrixTransform.h>
 #include <vsg/nodes/Node.h>
+#include <vsg/nodes/Occluder.h>
 #include <vsg/nodes/PagedLOD.h>
 #include <vsg/nodes/QuadGroup.h>
 #include <vsg/nodes/RegionOfInterest.h>
@@ -93,6 +97,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/animation/AnimationManager.h>
 #include <vsg/animation/CameraAnimationHandler.h>
 #include <vsg/animation/CameraSampler.h>
+#include <vsg/animation/ComputeSkinning.h>
 #include <vsg/animation/FindAnimations.h>
 #include <vsg/animation/Joint.h>
 #include <vsg/animation/JointSampler.h>
@@ -219,6 +224,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/CompileManager.h>
 #include <vsg/app/CompileTraversal.h>
 #include <vsg/app/EllipsoidModel.h>
+#include <vsg/app/OcclusionBuffer.h>
 #include <vsg/app/Presentation.h>
 #include <vsg/app/ProjectionMatrix.h>
 #include <vsg/app/RecordAndSubmitTask.h>
@@ -253,6 +259,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/InstanceExtensions.h>
 #include <vsg/vk/MemoryBufferPools.h>
 #include <vsg/vk/PhysicalDevice.h>
+#include <vsg/vk/PipelineCache.h>
 #include <vsg/vk/Queue.h>
 #include <vsg/vk/RenderPass.h>
 #include <vsg/vk/ResourceRequirements.h>
@@ -268,6 +275,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 // Input/Output header files
 #include <vsg/io/AsciiInput.h>
 #include <vsg/io/AsciiOutput.h>
+#include <vsg/io/AsyncLogger.h>
 #include <vsg/io/BinaryInput.h>
 #include <vsg/io/BinaryOutput.h>
 #include <vsg/io/DatabasePager.h>
@@ -281,6 +289,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Path.h>
 #include <vsg/io/ReaderWriter.h>
 #include <vsg/io/VSG.h>
+#include <vsg/io/compression.h>
 #include <vsg/io/convert_utf.h>
 #include <vsg/io/glsl.h>
 #include <vsg/io/json.h>
@@ -312,6 +321,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/utils/ShaderCompiler.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/utils/SharedObjects.h>
+#include <vsg/utils/SpirvCache.h>
 
 // Text header files
 #include <vsg/text/CpuLayoutTechnique.h>
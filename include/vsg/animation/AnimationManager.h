@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/animation/AnimationGroup.h>
+#include <vsg/threading/OperationThreads.h>
 #include <vsg/ui/FrameStamp.h>
 #include <vsg/utils/Instrumentation.h>
 
@@ -30,6 +31,13 @@ namespace vsg
 
         ref_ptr<Instrumentation> instrumentation;
 
+        /// number of threads, including the calling thread, used to update animations in parallel. 0 or 1 updates all animations serially.
+        /// Each animation is updated as an independent task, so animations played concurrently must not write to the same scene graph objects.
+        uint32_t numUpdateThreads = 0;
+
+        /// minimum number of animations being played before the updates are distributed across the update threads.
+        size_t minimumAnimationsForParallelUpdate = 16;
+
         /// assign instrumentation if required
         virtual void assignInstrumentation(ref_ptr<Instrumentation> in_instrumentation);
 
@@ -50,6 +58,13 @@ namespace vsg
 
     protected:
         double _simulationTime = 0.0;
+
+        /// update a contiguous range of animations, recording whether each one is still active
+        void _updateAnimations(size_t begin, size_t end);
+
+        ref_ptr<OperationThreads> _operationThreads;
+        std::vector<Animation*> _updateAnimationList;
+        std::vector<uint8_t> _updateResults;
     };
     VSG_type_name(vsg::AnimationManager);
 
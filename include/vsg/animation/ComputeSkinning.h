@@ -0,0 +1,111 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/Command.h>
+#include <vsg/core/Array.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/ComputePipeline.h>
+
+namespace vsg
+{
+
+    /// ComputeSkinning is a Command that dispatches a compute shader to skin the vertices and normals of a mesh for one or more instances,
+    /// writing the results to a device local buffer that is then used as the vertex arrays when drawing each instance. The vertices are skinned
+    /// once per frame and reused by every pass that draws them, such as the main view, shadow maps and picking, rather than being re-skinned
+    /// in the vertex shader of each pass. The joint matrix palettes of all the instances are packed into a single storage buffer.
+    ///
+    /// Usage:
+    /// 1. Create the ComputeSkinning with the bind pose vertices, normals, joint indices and weights, number of joints and number of instances.
+    /// 2. Assign instanceJointMatrices(i) to the JointSampler::jointMatrices of each instance so the JointSampler writes directly into the packed palettes.
+    /// 3. Replace the vertex and normal arrays of each instance's VertexIndexDraw/VertexDraw with skinnedVertices(i) and skinnedNormals(i),
+    ///    and use a ShaderSet configuration without the joint attributes/VSG_SKINNING define so the vertex shader doesn't skin the vertices again.
+    /// 4. Add the ComputeSkinning command to the CommandGraph before the RenderGraph(s), as compute dispatches can't be recorded inside a render pass.
+    ///
+    /// Requires VSG to be built with the ShaderCompiler.
+    class VSG_DECLSPEC ComputeSkinning : public Inherit<Command, ComputeSkinning>
+    {
+    public:
+        ComputeSkinning();
+        ComputeSkinning(const ComputeSkinning& rhs, const CopyOp& copyop = {});
+        ComputeSkinning(ref_ptr<vec3Array> in_vertices, ref_ptr<vec3Array> in_normals, ref_ptr<Data> in_jointIndices, ref_ptr<vec4Array> in_jointWeights, uint32_t in_jointCount, uint32_t in_instanceCount = 1);
+
+        /// bind pose vertices and optional normals, shared by all the instances.
+        ref_ptr<vec3Array> vertices;
+        ref_ptr<vec3Array> normals;
+
+        /// per vertex joint indices, an ivec4Array, uivec4Array, usvec4Array or ubvec4Array.
+        ref_ptr<Data> jointIndices;
+
+        /// per vertex joint weights.
+        ref_ptr<vec4Array> jointWeights;
+
+        /// number of joints in each instance's joint matrix palette.
+        uint32_t jointCount = 0;
+
+        /// number of skinned instances.
+        uint32_t instanceCount = 1;
+
+        /// joint matrix palettes of all the instances packed into a single array, instance i uses elements [i * jointCount, (i + 1) * jointCount).
+        ref_ptr<mat4Array> jointMatrices;
+
+        /// return the joint matrix palette of the specified instance, a view into jointMatrices that can be assigned to JointSampler::jointMatrices.
+        ref_ptr<mat4Array> instanceJointMatrices(uint32_t instance);
+
+        /// return the skinned vertices of the specified instance, to be used as the vertex array of the instance's VertexIndexDraw/VertexDraw.
+        ref_ptr<BufferInfo> skinnedVertices(uint32_t instance);
+
+        /// return the skinned normals of the specified instance, to be used as the normal array of the instance's VertexIndexDraw/VertexDraw.
+        ref_ptr<BufferInfo> skinnedNormals(uint32_t instance);
+
+        static constexpr uint32_t workgroupSize = 64;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return ComputeSkinning::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            if (node._bindComputePipeline) node._bindComputePipeline->accept(visitor);
+            if (node._bindDescriptorSet) node._bindDescriptorSet->accept(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~ComputeSkinning();
+
+        /// set up the packed joint matrices, skinned output buffer, compute pipeline and descriptor set if not already set up.
+        void _setUp();
+
+        ref_ptr<Buffer> _skinnedBuffer;
+        VkDeviceSize _skinnedNormalsOffset = 0;
+        uint32_t _attributeMask = 0;
+
+        std::vector<ref_ptr<mat4Array>> _instanceJointMatrices;
+        mutable std::vector<ModifiedCount> _instanceModifiedCounts;
+
+        ref_ptr<BindComputePipeline> _bindComputePipeline;
+        ref_ptr<BindDescriptorSet> _bindDescriptorSet;
+    };
+    VSG_type_name(vsg::ComputeSkinning);
+
+} // namespace vsg
@@ -98,6 +98,12 @@ namespace vsg
         void apply(Joint& joint) override;
         void apply(LookAt& lookAt) override;
         void apply(Camera& camera) override;
+
+    protected:
+        /// cached keyframe indices from the previous update, used to make sampling O(1) for monotonic time
+        size_t _positionCursor = 0;
+        size_t _rotationCursor = 0;
+        size_t _scaleCursor = 0;
     };
     VSG_type_name(vsg::TransformSampler);
 
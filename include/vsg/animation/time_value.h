@@ -79,4 +79,61 @@ namespace vsg
         }
     }
 
+    /// sample keyframes using a cursor that caches the index of the upper keyframe used by the previous call.
+    /// When time advances monotonically, or moves back a little, the keyframe interval is found in O(1) by stepping
+    /// from the cursor, only falling back to a binary search when the time jumps across several keyframes.
+    template<typename T, typename V>
+    bool sample(double time, const T& values, V& value, size_t& cursor)
+    {
+        if (values.size() == 0) return false;
+
+        if (values.size() == 1 || time <= values.front().time)
+        {
+            cursor = 0;
+            value = values.front().value;
+            return true;
+        }
+
+        if (time >= values.back().time)
+        {
+            cursor = values.size() - 1;
+            value = values.back().value;
+            return true;
+        }
+
+        // keyframe interval is values[i-1].time < time <= values[i].time, the front/back checks above guarantee 0 < i < values.size()
+        size_t i = (cursor > 0 && cursor < values.size()) ? cursor : 1;
+
+        constexpr size_t maxSteps = 4;
+        size_t steps = 0;
+        while (values[i].time < time && steps < maxSteps)
+        {
+            ++i;
+            ++steps;
+        }
+        while (values[i - 1].time >= time && steps < maxSteps)
+        {
+            --i;
+            ++steps;
+        }
+
+        if (values[i].time < time || values[i - 1].time >= time)
+        {
+            using value_type = typename T::value_type;
+            auto pos_itr = std::lower_bound(values.begin(), values.end(), time, [](const value_type& elem, double t) -> bool { return elem.time < t; });
+            i = static_cast<size_t>(pos_itr - values.begin());
+        }
+
+        cursor = i;
+
+        const auto& before = values[i - 1];
+        const auto& after = values[i];
+        double delta_time = (after.time - before.time);
+        double r = delta_time != 0.0 ? (time - before.time) / delta_time : 0.5;
+
+        value = mix(before.value, after.value, r);
+
+        return true;
+    }
+
 } // namespace vsg
@@ -0,0 +1,76 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/maths/mat4.h>
+#include <vsg/maths/sphere.h>
+
+#include <vector>
+
+namespace vsg
+{
+
+    /// OcclusionBuffer is a low resolution CPU depth buffer used by the RecordTraversal for occlusion culling.
+    /// Occluder nodes rasterize their simplified occluder meshes into the buffer as they are traversed, and the bounds of
+    /// subsequently traversed CullGroup, CullNode and LOD nodes are tested against it, with subgraphs that are completely hidden
+    /// behind previously rasterized occluders being culled. Depth is stored as eye space distance and a per tile maximum is
+    /// maintained so that tests are conservative and only require checking the tiles overlapped by the projected bound.
+    /// Occlusion culling is only applied for perspective projections.
+    class VSG_DECLSPEC OcclusionBuffer : public Inherit<Object, OcclusionBuffer>
+    {
+    public:
+        explicit OcclusionBuffer(uint32_t in_width = 256, uint32_t in_height = 128);
+
+        static constexpr uint32_t tileSize = 8;
+
+        const uint32_t width;
+        const uint32_t height;
+
+        /// minimum eye space distance of occluder vertices, triangles with vertices nearer than this are not rasterized.
+        double nearDistance = 1e-3;
+
+        /// reset the depth buffer and stats, called by RecordTraversal at the start of each View traversal.
+        void clear();
+
+        /// rasterize the triangles defined by vertices and ushortArray/uintArray indices, or triangle list if indices is null.
+        void rasterize(const dmat4& projection, const dmat4& modelview, const vec3Array& vertices, const Data* indices);
+
+        /// return true if the sphere, specified in the local coordinate frame of modelview, is completely hidden by previously rasterized occluders.
+        bool occluded(const dmat4& projection, const dmat4& modelview, const dsphere& sphere);
+
+        /// stats for the most recent View traversal
+        uint32_t numOccludersRasterized = 0;
+        uint32_t numTrianglesRasterized = 0;
+        uint32_t numTested = 0;
+        uint32_t numOccluded = 0;
+
+    protected:
+        virtual ~OcclusionBuffer();
+
+        void _rasterizeTriangle(const dvec4& c0, const dvec4& c1, const dvec4& c2);
+        void _updateTiles();
+
+        uint32_t _numTilesX = 0;
+        uint32_t _numTilesY = 0;
+        std::vector<float> _depth;
+        std::vector<float> _tileDepth;
+
+        // pixel region modified since the tile depths were last updated
+        int32_t _dirtyMinX, _dirtyMinY, _dirtyMaxX, _dirtyMaxY;
+        bool _empty = true;
+    };
+    VSG_type_name(vsg::OcclusionBuffer);
+
+} // namespace vsg
@@ -18,6 +18,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/maths/mat4.h>
 #include <vsg/vk/Slots.h>
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -33,6 +34,9 @@ namespace vsg
     class StateGroup;
     class CullGroup;
     class CullNode;
+    class BatchCullGroup;
+    class Occluder;
+    class OcclusionBuffer;
     class DepthSorted;
     class Layer;
     class Transform;
@@ -123,6 +127,8 @@ namespace vsg
         void apply(const TileDatabase& tileDatabase);
         void apply(const CullGroup& cullGroup);
         void apply(const CullNode& cullNode);
+        void apply(const BatchCullGroup& batchCullGroup);
+        void apply(const Occluder& occluder);
         void apply(const DepthSorted& depthSorted);
         void apply(const Layer& layer);
         void apply(const Switch& sw);
@@ -183,9 +189,16 @@ namespace vsg
         int32_t minimumBinNumber = 0;
         std::vector<ref_ptr<Bin>> bins;
         ref_ptr<ViewDependentState> viewDependentState;
+        ref_ptr<OcclusionBuffer> occlusionBuffer;
+
+        /// return the OcclusionBuffer that this RecordTraversal used for the specified View, or nullptr if none has been used.
+        OcclusionBuffer* getOcclusionBuffer(const View& view) const;
 
     protected:
         virtual ~RecordTraversal();
+
+        // per View OcclusionBuffer set up from the settings of the View::occlusionBuffer, so that a View can be recorded by multiple RecordTraversal concurrently
+        std::map<const View*, ref_ptr<OcclusionBuffer>> _occlusionBuffers;
     };
 
 } // namespace vsg
@@ -59,4 +59,10 @@ namespace vsg
     /// convenience function that sets up SecondaryCommandGraph to render the specified scene graph from the specified Camera view
     extern VSG_DECLSPEC ref_ptr<SecondaryCommandGraph> createSecondaryCommandGraphForView(ref_ptr<Window> window, ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, uint32_t subpass, bool assignHeadlight = true);
 
+    /// convenience function that distributes the top level children of a Group, StateGroup or QuadGroup scenegraph between numPartitions SecondaryCommandGraph that all render from the specified Camera view,
+    /// balancing the partitions by the number of nodes in each child's subgraph. Returns the primary CommandGraph, whose RenderGraph uses ExecuteCommands to stitch together the secondary CommandBuffers,
+    /// followed by the SecondaryCommandGraph. When all are assigned to the Viewer via assignRecordAndSubmitTaskAndPresentation(..) each CommandGraph is recorded on its own thread with its own State.
+    /// Top level Light children are added to every partition, lights and depth sorted Bin within a partition's subgraph only affect that partition.
+    extern VSG_DECLSPEC CommandGraphs createParallelCommandGraphsForView(ref_ptr<Window> window, ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, uint32_t numPartitions, bool assignHeadlight = true);
+
 } // namespace vsg
@@ -81,6 +81,7 @@ namespace vsg
             ref_ptr<Buffer> staging;
             void* buffer_data = nullptr;
             std::vector<VkBufferCopy> copyRegions;
+            std::vector<DirtyRange> dirtyRanges;
             bool waitOnFence = false;
         };
 
@@ -21,6 +21,7 @@ namespace vsg
 
     // forward declare
     class ViewDependentState;
+    class OcclusionBuffer;
 
     /// ViewFeatures mask provide a means for controlling what features should be implemented by the View's ViewDependentState.
     enum ViewFeatures
@@ -86,6 +87,11 @@ namespace vsg
         /// view dependent state used for positional state like lighting, texgen and clipping
         ref_ptr<ViewDependentState> viewDependentState;
 
+        /// optional occlusion buffer, when assigned Occluder nodes are rasterized into an OcclusionBuffer and used to cull hidden CullGroup, CullNode and LOD subgraphs.
+        /// The assigned OcclusionBuffer provides the settings, each RecordTraversal rasterizes into its own OcclusionBuffer with the same width, height and nearDistance
+        /// so the View can be recorded from multiple threads. Use RecordTraversal::getOcclusionBuffer(view) to access the stats of the most recent traversal.
+        ref_ptr<OcclusionBuffer> occlusionBuffer;
+
         /// override states for customization of graphics pipelines for this view
         GraphicsPipelineStates overridePipelineStates;
 
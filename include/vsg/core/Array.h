@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/core/Data.h>
+#include <vsg/core/MappedData.h>
 
 #include <vsg/maths/mat4.h>
 #include <vsg/maths/vec2.h>
@@ -173,6 +174,19 @@ namespace vsg
                 _storage = nullptr;
                 size_t new_total_size = computeValueCountIncludingMipmaps();
 
+                if constexpr (is_raw_binary<value_type>())
+                {
+                    // reference values directly in a memory mapped file rather than copying them
+                    if (auto [mapped, offset] = input.readMapped(new_total_size * sizeof(value_type), alignof(value_type)); mapped)
+                    {
+                        if (_data) _delete();
+                        _storage = mapped;
+                        _data = reinterpret_cast<value_type*>(static_cast<uint8_t*>(mapped->dataPointer()) + offset);
+                        dirty();
+                        return;
+                    }
+                }
+
                 if (_data) // if data exists already may be able to reuse it
                 {
                     if (original_total_size != new_total_size) // if existing data is a different size delete old, and create new
@@ -198,8 +212,11 @@ namespace vsg
             Data::write(output);
 
             output.writeValue<uint32_t>("size", _size);
-            output.writeObject("storage", _storage);
-            if (_storage)
+            // memory mapped file storage is transient so write its values inline
+            bool writeStorage = _storage && !_storage->is_compatible(typeid(MappedData));
+
+            output.writeObject("storage", writeStorage ? _storage.get() : nullptr);
+            if (writeStorage)
             {
                 auto offset = (reinterpret_cast<uintptr_t>(_data) - reinterpret_cast<uintptr_t>(_storage->dataPointer()));
                 output.writeValue<uint32_t>("offset", offset);
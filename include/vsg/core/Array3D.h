@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/core/Data.h>
+#include <vsg/core/MappedData.h>
 
 #include <vsg/maths/mat4.h>
 #include <vsg/maths/vec2.h>
@@ -162,6 +163,19 @@ namespace vsg
 
                 size_t new_size = computeValueCountIncludingMipmaps();
 
+                if constexpr (is_raw_binary<value_type>())
+                {
+                    // reference values directly in a memory mapped file rather than copying them
+                    if (auto [mapped, offset] = input.readMapped(new_size * sizeof(value_type), alignof(value_type)); mapped)
+                    {
+                        if (_data) _delete();
+                        _storage = mapped;
+                        _data = reinterpret_cast<value_type*>(static_cast<uint8_t*>(mapped->dataPointer()) + offset);
+                        dirty();
+                        return;
+                    }
+                }
+
                 if (_data) // if data exists already may be able to reuse it
                 {
                     if (original_size != new_size) // if existing data is a different size delete old, and create new
@@ -189,8 +203,11 @@ namespace vsg
             output.writeValue<uint32_t>("height", _height);
             output.writeValue<uint32_t>("depth", _depth);
 
-            output.writeObject("storage", _storage);
-            if (_storage)
+            // memory mapped file storage is transient so write its values inline
+            bool writeStorage = _storage && !_storage->is_compatible(typeid(MappedData));
+
+            output.writeObject("storage", writeStorage ? _storage.get() : nullptr);
+            if (writeStorage)
             {
                 auto offset = (reinterpret_cast<uintptr_t>(_data) - reinterpret_cast<uintptr_t>(_storage->dataPointer()));
                 output.writeValue<uint32_t>("offset", offset);
@@ -35,6 +35,8 @@ namespace vsg
     class StateGroup;
     class CullGroup;
     class CullNode;
+    class BatchCullGroup;
+    class Occluder;
     class Transform;
     class MatrixTransform;
     class CoordinateFrame;
@@ -342,6 +344,8 @@ namespace vsg
         virtual void apply(const StateGroup&);
         virtual void apply(const CullGroup&);
         virtual void apply(const CullNode&);
+        virtual void apply(const BatchCullGroup&);
+        virtual void apply(const Occluder&);
         virtual void apply(const Transform&);
         virtual void apply(const MatrixTransform&);
         virtual void apply(const CoordinateFrame&);
@@ -38,6 +38,14 @@ namespace vsg
         void operator++() { ++count; }
     };
 
+    /// DirtyRange specifies the byte range [begin, end) of a Data's values that have been modified, and the ModifiedCount of its most recent modification.
+    struct DirtyRange
+    {
+        size_t begin = 0;
+        size_t end = 0;
+        ModifiedCount modifiedCount;
+    };
+
     /** 64 bit block of compressed texel data.*/
     struct block64
     {
@@ -203,7 +211,25 @@ namespace vsg
         size_t computeValueCountIncludingMipmaps() const;
 
         /// increment the ModifiedCount to signify the data has been modified
-        void dirty() { ++_modifiedCount; }
+        void dirty()
+        {
+            ++_modifiedCount;
+            if (_dirtyRangesTracked) _clearDirtyRanges();
+        }
+
+        /// increment the ModifiedCount to signify that the byte range [begin, end) of dataPointer() has been modified.
+        /// Overlapping and adjacent ranges are coalesced so that TransferTask can copy just the modified ranges to the GPU.
+        void dirty(size_t begin, size_t end);
+
+        /// get the byte ranges modified since the specified ModifiedCount.
+        /// Return false if the modified ranges are unknown, in which case all the data should be treated as modified.
+        bool getDirtyRanges(const ModifiedCount& mc, std::vector<DirtyRange>& ranges) const;
+
+        /// discard the dirty ranges of modifications up to and including the specified ModifiedCount.
+        void pruneDirtyRanges(const ModifiedCount& mc);
+
+        /// maximum number of coalesced dirty ranges tracked before falling back to treating all the data as modified.
+        static constexpr size_t maxDirtyRanges = 256;
 
         /// get the Data's ModifiedCount and return true if this changes the specified ModifiedCount
         bool getModifiedCount(ModifiedCount& mc) const
@@ -232,8 +258,14 @@ namespace vsg
         void _copy(const Data& rhs);
         void _clear();
 
+        void _clearDirtyRanges();
+
         ModifiedCount _modifiedCount;
 
+        bool _dirtyRangesTracked = false;
+        ModifiedCount _dirtyRangesStart;
+        std::vector<DirtyRange> _dirtyRanges;
+
 #if 1
     public:
         /// deprecated: provided for backwards compatibility, use Properties instead.
@@ -14,6 +14,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/core/Allocator.h>
 
+#include <array>
+#include <atomic>
 #include <list>
 #include <string>
 #include <vector>
@@ -42,6 +44,12 @@ namespace vsg
     // The maximum size of allocations within the block allocation is (2^15-2) * 4, allocations larger than this
     // are allocated using aligned versions of std::new and std::delete.
     //
+    // Small allocations are served from per thread caches of slots for each AllocatorAffinity, each cache
+    // holding a magazine of slots per size class.  Magazines are refilled and drained in batches from the
+    // shared MemoryBlocks so the Allocator::mutex is only taken once per batch rather than once per call.
+    // Slots freed on a different thread from the one that allocated them are returned to the freeing thread's
+    // cache, with the owning MemoryBlock found via a lock free address index so no global lock is required.
+    //
     class VSG_DECLSPEC IntrusiveAllocator : public Allocator
     {
     public:
@@ -50,6 +58,13 @@ namespace vsg
 
         ~IntrusiveAllocator();
 
+        /// maximum number of slots held in each per thread, per size class magazine, set to 0 to disable thread caching.
+        /// Should be set before any allocations are made from additional threads.
+        size_t threadCacheSize = 64;
+
+        /// per thread cache of small slots, defined within IntrusiveAllocator.cpp
+        struct ThreadCache;
+
         void report(std::ostream& out) const override;
 
         void* allocate(std::size_t size, AllocatorAffinity allocatorAffinity = ALLOCATOR_AFFINITY_OBJECTS) override;
@@ -107,6 +122,12 @@ namespace vsg
                 Element() = default;
                 Element(const Element&) = default;
                 Element& operator=(const Element&) = default;
+
+                /// atomically read the whole header word, used by the ThreadCache to read slot headers without holding Allocator::mutex.
+                Element atomicLoad() const;
+
+                /// atomically update previous offset of a slot that may be allocated, so concurrent atomicLoad() calls see a consistent header.
+                void atomicSetPrevious(Offset in_previous);
             };
 
             struct FreeList
@@ -118,6 +139,7 @@ namespace vsg
             Element* memory = nullptr;
             Element* memoryEnd = nullptr;
 
+            uint32_t affinity = 0;
             size_t alignment = 8; // min alignment is 4 { sizeof(Element) }
             size_t blockAlignment = 16;
             size_t blockSize = 0;
@@ -172,11 +194,12 @@ namespace vsg
         class VSG_DECLSPEC MemoryBlocks
         {
         public:
-            MemoryBlocks(IntrusiveAllocator* in_parent, const std::string& in_name, size_t in_blockSize, size_t in_alignment);
+            MemoryBlocks(IntrusiveAllocator* in_parent, const std::string& in_name, uint32_t in_affinity, size_t in_blockSize, size_t in_alignment);
             virtual ~MemoryBlocks();
 
             IntrusiveAllocator* parent = nullptr;
             std::string name;
+            uint32_t affinity = 0;
             size_t alignment = 8;
             size_t blockSize = 0;
             size_t maximumAllocationSize = 0;
@@ -193,9 +216,60 @@ namespace vsg
             size_t totalMemorySize() const;
         };
 
+        // lock free mapping from an address to the MemoryBlock that contains it, used to deallocate into ThreadCache without taking the Allocator::mutex.
+        // Only MemoryBlock of at least the granularity are indexed, so each granule overlaps at most two of them: a lower block covering the start of
+        // the granule and an upper block starting within it. The address range of each is recorded so that lookups don't need to dereference the block.
+        class VSG_DECLSPEC MemoryBlockIndex
+        {
+        public:
+            static constexpr size_t granularityShift = 20; // 1 Megabyte granules
+            static constexpr size_t granularity = size_t(1) << granularityShift;
+
+            MemoryBlockIndex();
+            ~MemoryBlockIndex();
+
+            MemoryBlockIndex(const MemoryBlockIndex&) = delete;
+            MemoryBlockIndex& operator=(const MemoryBlockIndex&) = delete;
+
+            /// return the indexed MemoryBlock containing ptr, or nullptr if ptr isn't within an indexed MemoryBlock.
+            MemoryBlock* find(const void* ptr) const;
+
+            /// add block to the index, return false if block isn't suitable for indexing. Must be called with the Allocator::mutex held.
+            bool insert(MemoryBlock* block);
+
+            /// remove block from the index. Must be called with the Allocator::mutex held.
+            void remove(MemoryBlock* block);
+
+        protected:
+            static constexpr size_t leafBits = 14;
+            static constexpr size_t rootBits = 14;
+
+            struct Granule
+            {
+                std::atomic<MemoryBlock*> lower;
+                std::atomic<uintptr_t> lowerEnd;
+                std::atomic<MemoryBlock*> upper;
+                std::atomic<uintptr_t> upperStart;
+            };
+
+            struct Leaf
+            {
+                Granule granules[size_t(1) << leafBits];
+            };
+
+            Granule* granule(size_t key, bool create);
+
+            std::array<std::atomic<Leaf*>, size_t(1) << rootBits> root;
+        };
+
         std::vector<std::unique_ptr<MemoryBlocks>> allocatorMemoryBlocks;
         std::map<void*, std::shared_ptr<MemoryBlock>> memoryBlocks;
         std::map<void*, std::pair<size_t, size_t>> largeAllocations;
+
+        MemoryBlockIndex memoryBlockIndex;
+        std::vector<ThreadCache*> threadCaches;
+
+        ThreadCache* threadCache();
     };
 
 } // namespace vsg
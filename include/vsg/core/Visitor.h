@@ -35,6 +35,8 @@ namespace vsg
     class StateGroup;
     class CullGroup;
     class CullNode;
+    class BatchCullGroup;
+    class Occluder;
     class Transform;
     class MatrixTransform;
     class CoordinateFrame;
@@ -342,6 +344,8 @@ namespace vsg
         virtual void apply(StateGroup&);
         virtual void apply(CullGroup&);
         virtual void apply(CullNode&);
+        virtual void apply(BatchCullGroup&);
+        virtual void apply(Occluder&);
         virtual void apply(Transform&);
         virtual void apply(MatrixTransform&);
         virtual void apply(CoordinateFrame&);
@@ -0,0 +1,145 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Logger.h>
+#include <vsg/io/Path.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <sstream>
+
+namespace vsg
+{
+
+    /// Logger that formats messages on the calling thread and pushes them onto a bounded lock-free multi-producer single-consumer ring,
+    /// with a background thread writing them with timestamps and thread names to a file or a sink Logger.
+    /// Logging threads don't contend on Logger::_mutex, so debug logging from the pager and compile threads doesn't stall the frame loop.
+    /// To use the AsyncLogger use:
+    ///     vsg::Logger::instance() = AsyncLogger::create(); // writes to a StdLogger
+    ///     vsg::Logger::instance() = AsyncLogger::create(vsg::Path("vsg.log")); // writes to file
+    class VSG_DECLSPEC AsyncLogger : public Inherit<Logger, AsyncLogger>
+    {
+    public:
+        /// write messages to sink Logger, if no sink is assigned a StdLogger set to LOGGER_ALL is used.
+        explicit AsyncLogger(ref_ptr<Logger> in_sink = {}, size_t capacity = 4096);
+
+        /// write messages to file.
+        explicit AsyncLogger(const Path& filename, size_t capacity = 4096);
+
+        enum OverflowPolicy
+        {
+            OVERFLOW_DROP,  /// discard messages when the ring is full
+            OVERFLOW_BLOCK  /// wait for the background thread to make space in the ring
+        };
+
+        OverflowPolicy overflowPolicy = OVERFLOW_DROP;
+
+        /// maximum time the background thread sleeps before checking the ring for new messages.
+        std::chrono::milliseconds writeInterval{10};
+
+        std::string debugPrefix = "debug: ";
+        std::string infoPrefix = "info: ";
+        std::string warnPrefix = "Warning: ";
+        std::string errorPrefix = "ERROR: ";
+        std::string fatalPrefix = "FATAL: ";
+
+        /// assign name written in place of the std::thread::id for messages from the specified thread.
+        void setThreadName(std::thread::id id, const std::string& name);
+
+        /// number of messages pushed onto the ring.
+        uint64_t numMessagesLogged() const { return _numLogged.load(); }
+
+        /// number of messages written to the file or sink.
+        uint64_t numMessagesWritten() const { return _numWritten.load(); }
+
+        /// number of messages discarded because the ring was full and the overflowPolicy was OVERFLOW_DROP.
+        uint64_t numMessagesDropped() const { return _numDropped.load(); }
+
+        /// number of messages that had to wait for space in the ring because the overflowPolicy was OVERFLOW_BLOCK.
+        uint64_t numMessagesBlocked() const { return _numBlocked.load(); }
+
+        /// wait until all the messages logged so far have been written.
+        void flush() override;
+
+    protected:
+        virtual ~AsyncLogger();
+
+        using clock = std::chrono::steady_clock;
+
+        struct Record
+        {
+            Level level = LOGGER_INFO;
+            std::thread::id threadID;
+            clock::time_point time;
+            std::string message;
+        };
+
+        struct Slot
+        {
+            std::atomic<uint64_t> sequence{0};
+            Record record;
+        };
+
+        void _start(size_t capacity);
+        bool _push(Level msg_level, const std::string_view& message, bool block);
+        bool _pop(Record& record);
+        void _write(const Record& record);
+        void _run();
+
+        void debug_implementation(const std::string_view& message) override;
+        void info_implementation(const std::string_view& message) override;
+        void warn_implementation(const std::string_view& message) override;
+        void error_implementation(const std::string_view& message) override;
+        void fatal_implementation(const std::string_view& message) override;
+
+        ref_ptr<Logger> _sink;
+        FILE* _file = nullptr;
+
+        std::unique_ptr<Slot[]> _slots;
+        uint64_t _capacity = 0;
+        std::atomic<uint64_t> _enqueuePosition{0};
+        uint64_t _dequeuePosition = 0;
+
+        std::atomic<uint64_t> _numLogged{0};
+        std::atomic<uint64_t> _numWritten{0};
+        std::atomic<uint64_t> _numDropped{0};
+        std::atomic<uint64_t> _numBlocked{0};
+
+        clock::time_point _startTime;
+        std::atomic_bool _active{true};
+        std::atomic_bool _sleeping{false};
+        std::mutex _wakeMutex;
+        std::condition_variable _wakeCondition;
+        std::thread _thread;
+
+        std::atomic<uint32_t> _numSpaceWaiting{0};
+        std::mutex _spaceMutex;
+        std::condition_variable _spaceCondition;
+
+        std::atomic<uint32_t> _numFlushWaiting{0};
+        std::mutex _flushMutex;
+        std::condition_variable _flushCondition;
+
+        std::mutex _threadNamesMutex;
+        std::map<std::thread::id, std::string> _threadNames;
+        std::string _threadName;
+        std::ostringstream _threadIDStream;
+        std::string _line;
+    };
+    VSG_type_name(vsg::AsyncLogger);
+
+} // namespace vsg
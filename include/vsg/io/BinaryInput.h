@@ -12,10 +12,14 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/MappedData.h>
 #include <vsg/core/Object.h>
 
 #include <vsg/io/Input.h>
+#include <vsg/io/ObjectFactory.h>
 #include <vsg/io/Options.h>
+#include <vsg/io/compression.h>
+#include <vsg/threading/OperationThreads.h>
 
 #include <fstream>
 
@@ -41,9 +45,15 @@ namespace vsg
         template<typename T>
         void _read(size_t num, T* value)
         {
-            _input.read(reinterpret_cast<char*>(value), num * sizeof(T));
+            _readBytes(value, num * sizeof(T));
         }
 
+        /// read size bytes, from a chunk when size is at least chunkThreshold, otherwise inline skipping any alignment padding.
+        void _readBytes(void* ptr, size_t size);
+
+        /// skip the padding written by BinaryOutput ahead of large values so that they start on an alignment boundary.
+        void _skipPadding();
+
         // read value(s)
         void read(size_t num, int8_t* value) override { _read(num, value); }
         void read(size_t num, uint8_t* value) override { _read(num, value); }
@@ -75,8 +85,56 @@ namespace vsg
         /// read object
         vsg::ref_ptr<vsg::Object> read() override;
 
+        /// return mappedData and the offset of the next size bytes when they are at least minimumMappedSize and suitably aligned.
+        std::pair<ref_ptr<Data>, size_t> readMapped(size_t size, size_t valueAlignment) override;
+
+        /// alignment of values of alignmentThreshold bytes or larger, relative to the start of the file, read from the .vsgb header. 0 for unaligned files.
+        uint32_t alignment = 0;
+        uint32_t alignmentThreshold = 0;
+        std::streampos alignmentOrigin = 0;
+
+        /// when assigned, the input stream is reading directly from the memory mapped file.
+        ref_ptr<MappedData> mappedData;
+
+        /// minimum size in bytes of arrays that reference mappedData rather than being copied.
+        size_t minimumMappedSize = 4096;
+
+        /// when true class names are read via the class name table written by BinaryOutput, set from the .vsgb header.
+        bool classTable = false;
+
+        /// when non zero, values of chunkThreshold bytes or larger are read from separately compressed chunks, set from the .vsgb header.
+        uint32_t chunkThreshold = 0;
+
+        /// read the chunk index from the footer of a chunked file and decompress all the compressed chunks, in parallel when operationThreads are assigned.
+        /// Requires a seekable stream, returns false if the file isn't chunked or has no valid footer, in which case chunks are decompressed as they are read.
+        bool decompressChunks(ref_ptr<OperationThreads> operationThreads);
+
     protected:
         std::istream& _input;
+
+        /// create an object of the class in the class name table, caching the create function unless the objectFactory is a subclass that may override ObjectFactory::create()
+        ref_ptr<Object> _create(uint32_t classIndex);
+
+        /// record object against its ID, objects are stored in a dense vector as BinaryOutput assigns IDs sequentially,
+        /// with objectIDMap used for IDs assigned externally, such as by vsg::External, or far outside the dense range.
+        void _assign(ObjectID id, ref_ptr<Object> object);
+
+        struct ClassEntry
+        {
+            std::string className;
+            ObjectFactory::CreateFunction create;
+        };
+
+        std::vector<ClassEntry> _classes;
+        std::vector<ref_ptr<Object>> _objects;
+        std::vector<bool> _objectAssigned;
+
+        void _readChunk(void* ptr, size_t size);
+
+        /// validated chunk index read from the footer by decompressChunks(), empty if it hasn't been read.
+        std::vector<ChunkIndexEntry> _chunkIndex;
+        std::vector<std::vector<uint8_t>> _decompressedChunks;
+        std::vector<uint8_t> _compressedBuffer;
     };
 
 } // namespace vsg
@@ -14,8 +14,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/io/Options.h>
 #include <vsg/io/Output.h>
+#include <vsg/io/compression.h>
 
 #include <fstream>
+#include <unordered_map>
 
 namespace vsg
 {
@@ -36,9 +38,12 @@ namespace vsg
         template<typename T>
         void _write(size_t num, const T* value)
         {
-            _output.write(reinterpret_cast<const char*>(value), num * sizeof(T));
+            _writeBytes(value, num * sizeof(T));
         }
 
+        /// write size bytes, as a chunk when size is at least chunkThreshold, otherwise inline with any required alignment padding.
+        void _writeBytes(const void* ptr, size_t size);
+
         // write contiguous array of value(s)
         void write(size_t num, const int8_t* value) override { _write(num, value); }
         void write(size_t num, const uint8_t* value) override { _write(num, value); }
@@ -52,6 +57,9 @@ namespace vsg
         void write(size_t num, const double* value) override { _write(num, value); }
         void write(size_t num, const long double* value) override;
 
+        /// write zeros so the next value starts on an alignment boundary relative to the start of the stream.
+        void _writePadding();
+
         void _write(const std::string& str);
         void _write(const std::wstring& str);
 
@@ -62,8 +70,35 @@ namespace vsg
         /// write object
         void write(const vsg::Object* object) override;
 
+        /// alignment of values of alignmentThreshold bytes or larger, relative to the start of the stream, so they can be memory mapped when read back. 0 disables padding.
+        /// Must be written to the .vsgb header so BinaryInput can skip the padding.
+        uint32_t alignment = 0;
+        uint32_t alignmentThreshold = 1024;
+        std::streampos alignmentOrigin = 0;
+
+        /// when true each class name is written once, on its first use, with later objects of that class referencing it by index.
+        /// Must be written to the .vsgb header so BinaryInput reads the class indices. Enabled by default by the VSG ReaderWriter.
+        bool classTable = false;
+
+        /// when non zero, values of chunkThreshold bytes or larger are written as separately compressed chunks, indexed by the footer written by writeChunkIndex().
+        /// Must be written to the .vsgb header so BinaryInput reads the chunks.
+        uint32_t chunkThreshold = 0;
+        CompressionCodec compressionCodec = COMPRESSION_NONE;
+        int compressionLevel = 3;
+
+        /// write the footer index of the chunks, to be called after all the objects have been written.
+        void writeChunkIndex();
+
     protected:
         std::ostream& _output;
+
+        /// class name table indices, keyed by the className() pointer so that no string hashing is required. 0 is reserved for nullptr.
+        std::unordered_map<const char*, uint32_t> _classIndices;
+
+        void _writeChunk(const void* ptr, size_t size);
+
+        std::vector<ChunkIndexEntry> _chunkIndex;
+        std::vector<uint8_t> _compressionBuffer;
     };
 
 } // namespace vsg
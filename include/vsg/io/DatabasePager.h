@@ -23,7 +23,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <condition_variable>
 #include <list>
+#include <map>
 #include <thread>
+#include <unordered_map>
 
 namespace vsg
 {
@@ -90,6 +92,8 @@ namespace vsg
     };
 
     /// Thread safe queue for tracking PagedLOD that needs to be loaded, compiled or merged by the DatabasePager
+    /// PagedLOD that are ready to load are held in an indexed max heap ordered on PagedLOD::priority so the highest priority can be taken in O(log n),
+    /// while PagedLOD that are waiting on their PagedLOD::frameNextLoadAttempt are held in a separate deferred container until that frame is reached.
     class VSG_DECLSPEC DatabaseQueue : public Inherit<Object, DatabaseQueue>
     {
     public:
@@ -100,11 +104,18 @@ namespace vsg
         ActivityStatus* getStatus() { return _status; }
         const ActivityStatus* getStatus() const { return _status; }
 
+        /// maximum number of queued entries checked for expiry by each prune(..) call.
+        uint32_t maxNumPrunedChecksPerFrame = 256;
+
         void add(ref_ptr<PagedLOD> plod);
 
         void add(ref_ptr<PagedLOD> plod, const CompileResult& cr);
 
-        /// prune entries older than specified frameCount
+        /// reposition plod in the queue to reflect an increase in its PagedLOD::priority, no-op if plod isn't in the queue.
+        void updatePriority(const PagedLOD* plod);
+
+        /// prune entries older than specified frameCount, checking a bounded number of entries per call.
+        /// Returns the number of entries removed since the previous prune, including expired entries discarded by take_when_available(..).
         uint32_t prune(uint64_t frameCount);
 
         ref_ptr<PagedLOD> take_when_available(uint64_t frameCount);
@@ -114,9 +125,34 @@ namespace vsg
     protected:
         virtual ~DatabaseQueue();
 
+        struct Entry
+        {
+            ref_ptr<PagedLOD> plod;
+            double priority = 0.0;
+        };
+
+        void _push(ref_ptr<PagedLOD> plod);
+        ref_ptr<PagedLOD> _pop();
+        void _removeAt(size_t position);
+        void _siftUp(size_t position);
+        void _siftDown(size_t position);
+        void _promoteDeferred(uint64_t frameCount);
+        void _expire(PagedLOD* plod);
+
         std::mutex _mutex;
         std::condition_variable _cv;
-        Nodes _queue;
+        std::vector<Entry> _available;
+        std::unordered_map<const PagedLOD*, size_t> _availableIndices;
+        // deferred entries are keyed by {frameNextLoadAttempt, sequence number} so that each key is unique and the prune cursor can resume from a key
+        using DeferredKey = std::pair<uint64_t, uint64_t>;
+        using Deferred = std::map<DeferredKey, ref_ptr<PagedLOD>>;
+        Deferred _deferred;
+        std::unordered_map<const PagedLOD*, Deferred::iterator> _deferredIndices;
+        uint64_t _deferredSequence = 0;
+        DeferredKey _deferredPruneCursor;
+        uint64_t _frameCount = 0;
+        size_t _pruneCursor = 0;
+        uint32_t _numExpired = 0;
         CompileResult _compileResult;
         ref_ptr<ActivityStatus> _status;
     };
@@ -136,6 +172,9 @@ namespace vsg
 
         virtual void request(ref_ptr<PagedLOD> plod);
 
+        /// notify the DatabasePager that the priority of an already requested PagedLOD has increased.
+        virtual void updatePriority(const PagedLOD* plod);
+
         virtual void updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResult& cr);
 
         ref_ptr<CompileManager> compileManager;
@@ -66,4 +66,7 @@ namespace vsg
     /// Open a file using the C style fopen() adapted to work with the vsg::Path.
     extern VSG_DECLSPEC FILE* fopen(const Path& path, const char* mode);
 
+    /// rename a file, replacing the destination file if it exists, return true on success.
+    extern VSG_DECLSPEC bool renameFile(const Path& from, const Path& to);
+
 } // namespace vsg
@@ -38,6 +38,14 @@ namespace vsg
     // forward declare
     class Options;
 
+    /// return true if values of type T are serialized as a contiguous block of bytes matching their in memory representation.
+    template<typename T>
+    constexpr bool is_raw_binary()
+    {
+        return !has_read_write<T>() && std::is_trivially_copyable_v<T> &&
+               !std::is_same_v<T, long double> && !std::is_same_v<T, ldvec2> && !std::is_same_v<T, ldvec3> && !std::is_same_v<T, ldvec4> && !std::is_same_v<T, ldmat4>;
+    }
+
     /// Base class that provides a means of reading a range of data types from an input stream.
     /// Used by vsg::Object::read(Input&) implementations across the VSG to provide native serialization from binary/ascii files
     class VSG_DECLSPEC Input
@@ -70,6 +78,10 @@ namespace vsg
         // read object
         virtual ref_ptr<Object> read() = 0;
 
+        /// return the Data and offset of the next size bytes of the input stream if they can be referenced in place without copying, advancing the stream past them,
+        /// otherwise returns {nullptr, 0} leaving the stream unchanged. Used by Array classes to avoid copying large arrays from memory mapped files.
+        virtual std::pair<ref_ptr<Data>, size_t> readMapped(size_t /*size*/, size_t /*alignment*/) { return {}; }
+
         // map char to int8_t
         void read(size_t num, char* value) { read(num, reinterpret_cast<int8_t*>(value)); }
         void read(size_t num, bool* value) { read(num, reinterpret_cast<int8_t*>(value)); }
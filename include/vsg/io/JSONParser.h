@@ -23,11 +23,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 </editor-fold> */
 
+#include <vsg/core/Array.h>
 #include <vsg/core/Objects.h>
 #include <vsg/io/ReaderWriter.h>
 #include <vsg/io/mem_stream.h>
 #include <vsg/io/stream.h>
 
+#include <charconv>
+#include <cmath>
+#include <limits>
 #include <list>
 
 namespace vsg
@@ -52,6 +56,7 @@ namespace vsg
             virtual void read_object(JSONParser& parser);
             virtual void read_string(JSONParser& parser);
             virtual void read_number(JSONParser& parser, std::istream& input);
+            virtual void read_number(JSONParser& parser, const std::string_view& value); // default implementation calls read_number(parser, std::istream&)
             virtual void read_bool(JSONParser& parser, bool value);
             virtual void read_null(JSONParser& parser);
 
@@ -60,16 +65,65 @@ namespace vsg
             virtual void read_object(JSONParser& parser, const std::string_view& name);
             virtual void read_string(JSONParser& parser, const std::string_view& name);
             virtual void read_number(JSONParser& parser, const std::string_view& name, std::istream& input);
+            virtual void read_number(JSONParser& parser, const std::string_view& name, const std::string_view& value); // default implementation calls read_number(parser, name, std::istream&)
             virtual void read_bool(JSONParser& parser, const std::string_view& name, bool value);
             virtual void read_null(JSONParser& parser, const std::string_view& name);
         };
 
+        /// read a uri, data uris are returned as a stringValue of the encoded data with value set to the mime type, other uris are loaded with vsg::read().
         bool read_uri(std::string& value, ref_ptr<Object>& object);
+
+        /// read a uri as read_uri(), but with base64 encoded data uris decoded directly from the buffer into a ubyteArray.
+        bool read_uri_data(std::string& value, ref_ptr<Object>& object);
         bool read_string_view(std::string_view& value);
         bool read_string(std::string& value);
         void read_object(Schema& schema);
         void read_array(Schema& schema);
 
+        /// count the number of elements in the array starting at the current position, without advancing the position.
+        std::size_t count_array_elements() const;
+
+        /// read an array of numbers into a vsg::Array<T>, counting the elements first so the Array is allocated once.
+        template<typename T>
+        ref_ptr<Array<T>> read_values();
+
+        /// parse a number using std::from_chars, independent of locale. Returns false if the whole string could not be parsed
+        /// or the value is out of range of T, in which case value is left unchanged.
+        template<typename T>
+        static bool parse_number(const std::string_view& str, T& value)
+        {
+            if constexpr (std::is_integral_v<T>)
+            {
+                auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+                if (ec == std::errc() && ptr == str.data() + str.size()) return true;
+
+                // fallback to handle integers written as floating point values, i.e. 1.0 or 1e3
+                double d;
+                if (!parse_number(str, d)) return false;
+
+                // 2^digits is one past the maximum of T and exactly representable as a double, NaN fails both comparisons
+                const double upper = std::ldexp(1.0, std::numeric_limits<T>::digits);
+                const double lower = std::is_signed_v<T> ? -upper : 0.0;
+                if (!(d >= lower && d < upper)) return false;
+
+                value = static_cast<T>(d);
+                return true;
+            }
+            else
+            {
+                double d;
+                if (!parse_number(str, d)) return false;
+
+                // finite values beyond the range of T can't be converted
+                if (std::isfinite(d) && std::abs(d) > static_cast<double>(std::numeric_limits<T>::max())) return false;
+
+                value = static_cast<T>(d);
+                return true;
+            }
+        }
+
+        static bool parse_number(const std::string_view& str, double& value);
+
         std::pair<std::size_t, std::size_t> lineAndColumnAtPosition(std::size_t position) const;
         std::string_view lineEnclosingPosition(std::size_t position) const;
 
@@ -106,7 +160,7 @@ namespace vsg
         void read_array(JSONParser& parser) override;
         void read_object(JSONParser& parser) override;
         void read_string(JSONParser& parser) override;
-        void read_number(JSONParser& parser, std::istream& input) override;
+        void read_number(JSONParser& parser, const std::string_view& value) override;
         void read_bool(JSONParser& parser, bool value) override;
         void read_null(JSONParser& parser) override;
 
@@ -114,7 +168,7 @@ namespace vsg
         void read_array(JSONParser& parser, const std::string_view& name) override;
         void read_object(JSONParser& parser, const std::string_view& name) override;
         void read_string(JSONParser& parser, const std::string_view& name) override;
-        void read_number(JSONParser& parser, const std::string_view& name, std::istream& input) override;
+        void read_number(JSONParser& parser, const std::string_view& name, const std::string_view& value) override;
         void read_bool(JSONParser& parser, const std::string_view& name, bool value) override;
         void read_null(JSONParser& parser, const std::string_view& name) override;
     };
@@ -137,14 +191,45 @@ namespace vsg
     struct ValuesSchema : public Inherit<JSONParser::Schema, ValuesSchema<T>>
     {
         std::vector<T> values;
-        void read_number(vsg::JSONParser&, std::istream& input) override
+        void read_number(vsg::JSONParser& parser, const std::string_view& str) override
         {
-            T value;
-            input >> value;
+            T value{};
+            if (!parser.parse_number(str, value)) parser.warning("ValuesSchema::read_number() could not parse ", str);
             values.push_back(value);
         }
     };
 
+    /// Template class for reading an array of numeric values into a pre-sized vsg::Array<T>, see JSONParser::read_values<T>()
+    template<typename T>
+    struct ArraySchema : public Inherit<JSONParser::Schema, ArraySchema<T>>
+    {
+        ref_ptr<Array<T>> values;
+        std::size_t count = 0;
+
+        void read_number(vsg::JSONParser& parser, const std::string_view& str) override
+        {
+            if (!values || count >= values->size())
+            {
+                parser.warning("ArraySchema::read_number() more values than allocated.");
+                return;
+            }
+
+            if (!parser.parse_number(str, values->at(count))) parser.warning("ArraySchema::read_number() could not parse ", str);
+            ++count;
+        }
+    };
+
+    template<typename T>
+    ref_ptr<Array<T>> JSONParser::read_values()
+    {
+        ArraySchema<T> schema;
+        schema.values = Array<T>::create(static_cast<uint32_t>(count_array_elements()));
+        read_array(schema);
+
+        if (schema.count != schema.values->size()) warning("JSONParser::read_values() read ", schema.count, " values, expected ", schema.values->size());
+        return schema.values;
+    }
+
     /// Template class for reading an array of objects
     template<typename T>
     struct ObjectsSchema : public Inherit<JSONParser::Schema, ObjectsSchema<T>>
@@ -60,8 +60,7 @@ namespace vsg
         {
             if (level > LOGGER_DEBUG) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            debug_implementation(str);
+            _dispatch(LOGGER_DEBUG, str);
         }
 
         template<typename... Args>
@@ -69,12 +68,10 @@ namespace vsg
         {
             if (level > LOGGER_DEBUG) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            _stream.str({});
-            _stream.clear();
-            (_stream << ... << args);
+            auto& stream = _threadStream();
+            (stream << ... << args);
 
-            debug_implementation(_stream.str());
+            _dispatch(LOGGER_DEBUG, stream.str());
         }
 
         inline void info(char* message) { info(std::string_view(message)); }
@@ -86,8 +83,7 @@ namespace vsg
         {
             if (level > LOGGER_INFO) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            info_implementation(str);
+            _dispatch(LOGGER_INFO, str);
         }
 
         template<typename... Args>
@@ -95,12 +91,10 @@ namespace vsg
         {
             if (level > LOGGER_INFO) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            _stream.str({});
-            _stream.clear();
-            (_stream << ... << args);
+            auto& stream = _threadStream();
+            (stream << ... << args);
 
-            info_implementation(_stream.str());
+            _dispatch(LOGGER_INFO, stream.str());
         }
 
         inline void warn(char* message) { warn(std::string_view(message)); }
@@ -112,8 +106,7 @@ namespace vsg
         {
             if (level > LOGGER_WARN) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            warn_implementation(str);
+            _dispatch(LOGGER_WARN, str);
         }
 
         template<typename... Args>
@@ -121,12 +114,10 @@ namespace vsg
         {
             if (level > LOGGER_WARN) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            _stream.str({});
-            _stream.clear();
-            (_stream << ... << args);
+            auto& stream = _threadStream();
+            (stream << ... << args);
 
-            warn_implementation(_stream.str());
+            _dispatch(LOGGER_WARN, stream.str());
         }
 
         inline void error(char* message) { error(std::string_view(message)); }
@@ -138,8 +129,7 @@ namespace vsg
         {
             if (level > LOGGER_ERROR) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            error_implementation(str);
+            _dispatch(LOGGER_ERROR, str);
         }
 
         template<typename... Args>
@@ -147,12 +137,10 @@ namespace vsg
         {
             if (level > LOGGER_ERROR) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            _stream.str({});
-            _stream.clear();
-            (_stream << ... << args);
+            auto& stream = _threadStream();
+            (stream << ... << args);
 
-            error_implementation(_stream.str());
+            _dispatch(LOGGER_ERROR, stream.str());
         }
 
         inline void fatal(char* message) { fatal(std::string_view(message)); }
@@ -164,8 +152,7 @@ namespace vsg
         {
             if (level > LOGGER_FATAL) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            fatal_implementation(str);
+            _dispatch(LOGGER_FATAL, str);
         }
 
         template<typename... Args>
@@ -173,12 +160,10 @@ namespace vsg
         {
             if (level > LOGGER_FATAL) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            _stream.str({});
-            _stream.clear();
-            (_stream << ... << args);
+            auto& stream = _threadStream();
+            (stream << ... << args);
 
-            fatal_implementation(_stream.str());
+            _dispatch(LOGGER_FATAL, stream.str());
         }
 
         using PrintToStreamFunction = std::function<void(std::ostream&)>;
@@ -212,20 +197,10 @@ namespace vsg
         {
             if (level > msg_level) return;
 
-            std::scoped_lock<std::mutex> lock(_mutex);
-            _stream.str({});
-            _stream.clear();
-            (_stream << ... << args);
-
-            switch (msg_level)
-            {
-            case (LOGGER_DEBUG): debug_implementation(_stream.str()); break;
-            case (LOGGER_INFO): info_implementation(_stream.str()); break;
-            case (LOGGER_WARN): warn_implementation(_stream.str()); break;
-            case (LOGGER_ERROR): error_implementation(_stream.str()); break;
-            case (LOGGER_FATAL): fatal_implementation(_stream.str()); break;
-            default: break;
-            }
+            auto& stream = _threadStream();
+            (stream << ... << args);
+
+            _dispatch(msg_level, stream.str());
         }
 
         /// thread safe access to stream for writing error output.
@@ -235,7 +210,15 @@ namespace vsg
         virtual ~Logger();
 
         std::mutex _mutex;
-        std::ostringstream _stream;
+
+        /// when true the *_implementation() methods are thread safe so are called without holding _mutex, i.e. AsyncLogger
+        bool _threadSafeImplementation = false;
+
+        /// cleared stream local to the calling thread, used to format messages without holding _mutex.
+        static std::ostringstream& _threadStream();
+
+        /// pass message to the *_implementation() method for msg_level, holding _mutex unless _threadSafeImplementation is true.
+        void _dispatch(Level msg_level, const std::string_view& message);
 
         std::unique_ptr<std::streambuf> _override_cout;
         std::unique_ptr<std::streambuf> _override_cerr;
@@ -97,7 +97,7 @@ namespace vsg
         /// Hook for assigning Instrumentation to enable profiling of record traversal.
         ref_ptr<Instrumentation> instrumentation;
 
-        /// mechanism for finding dynamic objects in loaded scene graph
+        /// mechanism for finding dynamic objects in loaded scene graph, when assigned vsg::read(..) enables dynamic object analysis using per call visitor instances.
         ref_ptr<FindDynamicObjects> findDynamicObjects;
 
         /// mechanism for propagating dynamic objects classification up parental chain so that cloning is done on all dynamic objects to avoid sharing of dynamic parts.
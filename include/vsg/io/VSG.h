@@ -18,6 +18,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 namespace vsg
 {
+    class BinaryInput;
+    class BinaryOutput;
 
     /// ReaderWriter for reading and writing native VSG ascii and binary files.
     class VSG_DECLSPEC VSG : public Inherit<ReaderWriter, VSG>
@@ -25,6 +27,24 @@ namespace vsg
     public:
         VSG();
 
+        /// bool option, when true .vsgb files are memory mapped and large arrays reference the mapped file directly rather than being copied.
+        static constexpr const char* memory_map = "memory_map";
+
+        /// uint32_t option, byte alignment of large arrays written to .vsgb files so they can be memory mapped when read back, 0 for unaligned.
+        static constexpr const char* alignment = "alignment";
+
+        /// bool option, when true .vsgb files are written with a class name table, with each class name written once and then referenced by a
+        /// small integer index. Off by default as versions of the VSG prior to the class name table can't read these files.
+        static constexpr const char* class_table = "class_table";
+
+        /// uint32_t option, values of at least this many bytes are written to .vsgb files as separate chunks, indexed by a footer so they can be
+        /// decompressed in parallel on Options::operationThreads when read. 0, the default, disables chunking.
+        static constexpr const char* chunk_threshold = "chunk_threshold";
+
+        /// std::string option, codec used to compress the chunks of .vsgb files, "none" or "zstd". "zstd" requires VSG_SUPPORTS_zstd and
+        /// enables chunking with a 64KB chunk_threshold if not otherwise set.
+        static constexpr const char* compression = "compression";
+
         vsg::ref_ptr<vsg::Object> read(const vsg::Path& filename, vsg::ref_ptr<const vsg::Options> options = {}) const override;
         vsg::ref_ptr<vsg::Object> read(std::istream& fin, vsg::ref_ptr<const vsg::Options> options = {}) const override;
         vsg::ref_ptr<vsg::Object> read(const uint8_t* ptr, size_t size, vsg::ref_ptr<const vsg::Options> = {}) const override;
@@ -49,7 +69,34 @@ namespace vsg
         FormatInfo readHeader(std::istream& fin) const;
         void writeHeader(std::ostream& fout, const FormatInfo& formatInfo) const;
 
+        /// read header along with the alignment settings of large arrays, alignmentValue is 0 for unaligned files.
+        FormatInfo readHeader(std::istream& fin, uint32_t& alignmentValue, uint32_t& alignmentThreshold) const;
+
+        /// write header along with the alignment settings of large arrays, the alignment settings are only written when alignmentValue is non zero.
+        void writeHeader(std::ostream& fout, const FormatInfo& formatInfo, uint32_t alignmentValue, uint32_t alignmentThreshold) const;
+
+        /// optional settings of .vsgb files, written to the header after the version.
+        struct BinarySettings
+        {
+            uint32_t alignment = 0;
+            uint32_t alignmentThreshold = 0;
+            bool classTable = false;
+            uint32_t chunkThreshold = 0;
+        };
+
+        /// read header along with the binary settings.
+        FormatInfo readHeader(std::istream& fin, BinarySettings& settings) const;
+
+        /// write header along with the binary settings, only the settings that differ from the defaults are written.
+        void writeHeader(std::ostream& fout, const FormatInfo& formatInfo, const BinarySettings& settings) const;
+
     protected:
+        /// assign the binary settings read from the header to the BinaryInput, decompressing chunks in parallel when options->operationThreads is assigned.
+        void assignSettings(BinaryInput& input, const BinarySettings& settings, const Options* options) const;
+
+        /// assign the alignment, class table, chunk and compression options to the BinaryOutput, returning the settings to write to the header.
+        BinarySettings assignSettings(BinaryOutput& output, const Options* options) const;
+
         ref_ptr<ObjectFactory> _objectFactory;
     };
     VSG_type_name(vsg::VSG);
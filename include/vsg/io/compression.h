@@ -0,0 +1,49 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Export.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace vsg
+{
+
+    /// codecs used to compress the chunks of chunked .vsgb files.
+    enum CompressionCodec : uint32_t
+    {
+        COMPRESSION_NONE = 0,
+        COMPRESSION_ZSTD = 1
+    };
+
+    /// return true if the codec is supported by this build of the VSG, COMPRESSION_ZSTD requires VSG_SUPPORTS_zstd.
+    extern VSG_DECLSPEC bool compressionSupported(CompressionCodec codec);
+
+    /// compress size bytes from src, replacing the contents of dest with the compressed bytes. Return false if the codec is unsupported or compression failed.
+    extern VSG_DECLSPEC bool compress(CompressionCodec codec, const void* src, size_t size, std::vector<uint8_t>& dest, int level = 3);
+
+    /// decompress compressedSize bytes from src into the size bytes of dest. Return false if the codec is unsupported or decompression failed.
+    extern VSG_DECLSPEC bool decompress(CompressionCodec codec, const void* src, size_t compressedSize, void* dest, size_t size);
+
+    /// entry in the footer index of a chunked .vsgb file, offset is relative to the start of the file.
+    struct ChunkIndexEntry
+    {
+        uint64_t offset = 0;
+        uint64_t compressedSize = 0;
+        uint64_t size = 0;
+        uint32_t codec = COMPRESSION_NONE;
+        uint32_t reserved = 0;
+    };
+
+} // namespace vsg
@@ -16,9 +16,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/TileDatabase.h>
 #include <vsg/nodes/VertexIndexDraw.h>
 #include <vsg/state/GraphicsPipeline.h>
+#include <vsg/threading/OperationThreads.h>
 #include <vsg/utils/GraphicsPipelineConfigurator.h>
 #include <vsg/utils/ShaderSet.h>
 
+#include <list>
+#include <tuple>
+
 namespace vsg
 {
 
@@ -37,11 +41,27 @@ namespace vsg
         /// read the tile
         ref_ptr<Object> read(const Path& filename, ref_ptr<const Options> options = {}) const override;
 
+        /// number of threads used to read tile layers concurrently when Options::operationThreads is not assigned, 0 reads layers on the calling thread.
+        uint32_t numReadThreads = 4;
+
         // timing stats
         mutable std::mutex statsMutex;
         mutable uint64_t numTilesRead{0};
         mutable double totalTimeReadingTiles{0.0};
 
+        /// maximum memory in bytes used by the geometry cache that shares tile meshes between tiles of the same shape, least recently used meshes are evicted first, 0 disables caching.
+        size_t geometryCacheMaxMemory = 64 * 1024 * 1024;
+
+        // geometry cache stats
+        mutable uint64_t numGeometryCacheHits{0};
+        mutable uint64_t numGeometryCacheMisses{0};
+        mutable uint64_t numGeometryCacheEvictions{0};
+        mutable size_t geometryCacheMemory{0};
+
+        // per layer timing stats, indexed by layer type, 0 -> imageLayer, 1 -> detailLayer, 2 -> elevationLayer
+        mutable uint64_t numLayersRead[3]{0, 0, 0};
+        mutable double totalTimeReadingLayers[3]{0.0, 0.0, 0.0};
+
     protected:
         /// initialize internal data structures
         void init(ref_ptr<const Options> options);
@@ -50,6 +70,22 @@ namespace vsg
         dbox computeTileExtents(uint32_t x, uint32_t y, uint32_t level) const;
         Path getTilePath(const Path& src, uint32_t x, uint32_t y, uint32_t level) const;
 
+        struct LayerRead
+        {
+            Path path;
+            uint32_t type = 0; // type = 0 -> imageLayer, 1 -> detailLayer, 2 -> elevationLayer
+            uint32_t local_x = 0;
+            uint32_t local_y = 0;
+            ref_ptr<Data> data;
+            double time = 0.0; // time to read in milliseconds
+        };
+
+        /// read all the layers concurrently using Options::operationThreads or the tile's internal threads, updating per layer timing stats.
+        void readLayers(std::vector<LayerRead>& layerReads, ref_ptr<const Options> options) const;
+
+        /// add LayerRead entries for each of the assigned image, detail and elevation layers of the specified tile
+        void addLayerReads(std::vector<LayerRead>& layerReads, uint32_t x, uint32_t y, uint32_t lod) const;
+
         ref_ptr<Object> read_root(ref_ptr<const Options> options = {}) const;
         ref_ptr<Object> read_subtile(uint32_t x, uint32_t y, uint32_t lod, ref_ptr<const Options> options = {}) const;
 
@@ -72,8 +108,46 @@ namespace vsg
         ref_ptr<DescriptorImage> _detailFallback;
         ref_ptr<DescriptorImage> _elevationFallback;
 
+        mutable std::mutex _operationThreadsMutex;
+        mutable ref_ptr<OperationThreads> _operationThreads;
+
+        /// normalized tile shape used to find tile meshes that can be shared, meshes are in a local frame so are independent of longitude.
+        struct GeometryKey
+        {
+            double latitudeMin = 0.0;
+            double latitudeRange = 0.0;
+            double longitudeRange = 0.0;
+            uint32_t numRows = 0;
+            uint32_t numCols = 0;
+            double skirtRatio = 0.0;
+            vec4 displacementMapScale; // w is 1.0 when displacementMapScale is assigned to the mesh
+
+            bool operator<(const GeometryKey& rhs) const
+            {
+                return std::tie(latitudeMin, latitudeRange, longitudeRange, numRows, numCols, skirtRatio, displacementMapScale) <
+                       std::tie(rhs.latitudeMin, rhs.latitudeRange, rhs.longitudeRange, rhs.numRows, rhs.numCols, rhs.skirtRatio, rhs.displacementMapScale);
+            }
+        };
+
+        struct GeometryEntry
+        {
+            GeometryKey key;
+            ref_ptr<VertexIndexDraw> vid;
+            size_t size = 0;
+        };
+
+        using GeometryLRU = std::list<GeometryEntry>;
+
+        /// get cached mesh for the specified key, returns null if none is available
+        ref_ptr<VertexIndexDraw> getCachedGeometry(const GeometryKey& key) const;
+
+        /// add mesh to the geometry cache evicting least recently used meshes to keep within geometryCacheMaxMemory
+        void addCachedGeometry(const GeometryKey& key, ref_ptr<VertexIndexDraw> vid) const;
+
         mutable std::mutex _geometryMapMutex;
-        mutable std::map<dvec4, ref_ptr<VertexIndexDraw>> _geometryMap;
+        mutable GeometryLRU _geometryLRU;
+        mutable std::map<GeometryKey, GeometryLRU::iterator> _geometryMap;
+        mutable size_t _geometryCacheMemory = 0;
     };
     VSG_type_name(vsg::tile);
 
@@ -0,0 +1,88 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Allocator.h>
+#include <vsg/core/ref_ptr.h>
+#include <vsg/maths/plane.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Node.h>
+
+namespace vsg
+{
+
+    /** BatchCullGroup is a CullGroup variant for nodes with many children that each have their own bounding sphere, such as tile grids or
+     *  large collections of objects. The child bounds are also stored as a structure of arrays of floats, relative to a local origin,
+     *  so that the view frustum test can be done on 4 children at a time using SSE2 or NEON when available, rather than testing
+     *  each child one at a time with a CullNode. The bound of the whole group is tested first, then the children are tested in batches.
+     *  If the children vector is modified directly, rather than via addChild(), call dirty() to rebuild the arrays.*/
+    class VSG_DECLSPEC BatchCullGroup : public Inherit<Node, BatchCullGroup>
+    {
+    public:
+        BatchCullGroup();
+        BatchCullGroup(const BatchCullGroup& rhs, const CopyOp& copyop = {});
+
+        struct Child
+        {
+            dsphere bound;
+            ref_ptr<Node> node;
+        };
+
+        using Children = std::vector<Child, allocator_affinity_nodes<Child>>;
+
+        /// bound enclosing all the children's bounds, computed by addChild() and dirty().
+        /// Invalid if any child has an invalid bound, in which case the group and that child are never culled.
+        dsphere bound;
+        Children children;
+
+        void addChild(const dsphere& childBound, ref_ptr<Node> child);
+
+        /// recompute the bound and the arrays of child bounds used for batched culling
+        void dirty();
+
+        /// return a bit mask of which of the 64 children starting at firstChild have bounds that intersect all the planes.
+        /// planes are in the local coordinate frame and point inwards, as used by vsg::Frustum.
+        uint64_t intersect(const dplane* planes, size_t numPlanes, size_t firstChild) const;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return BatchCullGroup::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            for (auto& child : node.children) child.node->accept(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+        void traverse(RecordTraversal& visitor) const override { t_traverse(*this, visitor); }
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~BatchCullGroup();
+
+        void _expandBound(const dsphere& childBound);
+        void _appendBound(size_t index, const dsphere& childBound);
+
+        bool _unbounded = false;
+
+        // child bounds relative to _origin, padded to a multiple of 4 with entries that always fail the intersection test
+        dvec3 _origin;
+        std::vector<float> _x, _y, _z, _radius;
+    };
+    VSG_type_name(vsg::BatchCullGroup);
+
+} // namespace vsg
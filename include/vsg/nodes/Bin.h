@@ -37,6 +37,10 @@ namespace vsg
         int32_t binNumber = 0;
         SortOrder sortOrder = NO_SORT;
 
+        /// when enabled, sorting starts from the previous frame's order and fixes it up with an insertion sort,
+        /// falling back to a full sort when the order has changed significantly. Suited to scenes where the camera moves only slightly between frames.
+        bool reuseSortOrder = false;
+
         void clear();
 
         void add(State* state, double value, const Node* node);
@@ -68,6 +72,15 @@ namespace vsg
 
         using KeyIndex = std::pair<float, uint32_t>;
         mutable std::vector<KeyIndex> _binElements;
+
+        // sort support
+        void _sort() const;
+        void _radixSort() const;
+        bool _insertionSort() const;
+
+        mutable std::vector<KeyIndex> _sortBuffer;
+        mutable std::vector<uint32_t> _sortKeys;
+        mutable std::vector<uint32_t> _previousOrder;
     };
     VSG_type_name(vsg::Bin);
 
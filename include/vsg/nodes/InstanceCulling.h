@@ -0,0 +1,99 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/Command.h>
+#include <vsg/commands/DrawIndexedIndirectCommand.h>
+#include <vsg/maths/mat4.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/InstanceNode.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/ComputePipeline.h>
+
+#include <limits>
+
+namespace vsg
+{
+
+    // forward declare
+    class Camera;
+
+    /// InstanceCulling is a Command that dispatches a compute shader to frustum and LOD cull the instances of an InstanceNode on the GPU.
+    /// The instances that survive culling are compacted into the arrays of the culledInstances InstanceNode, and the instanceCount of the
+    /// DrawIndexedIndirectCommand assigned to each InstanceDrawIndexed in the culledInstances subgraph is set to the number of visible instances,
+    /// so the CPU cost of recording stays constant regardless of the number of instances. The InstanceDrawIndexed, and the nodes above them,
+    /// are duplicated when compiled so the original subgraph isn't modified and can still be shared.
+    ///
+    /// Views that inherit their viewpoint, such as the shadow map views of ViewDependentState, see a different set of instances to the camera
+    /// so record all of the source instances rather than the culled instances.
+    ///
+    /// Usage:
+    /// 1. Set instances to an InstanceNode with the per instance translations and optional rotations, scales and colors, its child subgraph
+    ///    containing StateGroup and InstanceDrawIndexed nodes.
+    /// 2. Place culledInstances in the scene graph in place of instances.
+    /// 3. Add the InstanceCulling command to the CommandGraph before the RenderGraph, as compute dispatches can't be recorded inside a render pass.
+    ///
+    /// Instance arrays are read by the compute shader as tightly packed floats, so translations and scales must be vec3Array,
+    /// rotations a quatArray and colors a vec3Array or vec4Array. Requires VSG to be built with the ShaderCompiler.
+    class VSG_DECLSPEC InstanceCulling : public Inherit<Command, InstanceCulling>
+    {
+    public:
+        InstanceCulling();
+        InstanceCulling(const InstanceCulling& rhs, const CopyOp& copyop = {});
+        InstanceCulling(ref_ptr<Camera> in_camera, ref_ptr<InstanceNode> in_instances, const dsphere& in_bound);
+
+        /// Camera whose view frustum and LOD scale the instances are culled against.
+        ref_ptr<Camera> camera;
+
+        /// InstanceNode containing all the instances.
+        ref_ptr<InstanceNode> instances;
+
+        /// InstanceNode containing the visible instances, its arrays are written by the compute shader. Place in the scene graph to render the visible instances.
+        ref_ptr<InstanceNode> culledInstances;
+
+        /// local to world transform of the culledInstances in the scene graph.
+        dmat4 matrix;
+
+        /// bounding sphere of the instanced subgraph in its local coordinate frame, transformed by each instance's translation, rotation and scale when culling.
+        dsphere bound;
+
+        /// instances are LOD culled when bound.radius <= lodDistance * minimumScreenHeightRatio or bound.radius > lodDistance * maximumScreenHeightRatio,
+        /// with the same semantics as LOD::Child::minimumScreenHeightRatio, enabling multiple InstanceCulling to select the instances drawn by each LOD level.
+        float minimumScreenHeightRatio = 0.0f;
+        float maximumScreenHeightRatio = std::numeric_limits<float>::max();
+
+        static constexpr uint32_t workgroupSize = 64;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return InstanceCulling::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~InstanceCulling();
+
+        ref_ptr<BindComputePipeline> _bindComputePipeline;
+        ref_ptr<BindDescriptorSet> _bindDescriptorSet;
+        ref_ptr<BufferInfo> _drawCommands;
+        ref_ptr<BufferInfo> _drawCommandsSource;
+        ref_ptr<DrawIndexedIndirectCommandArray> _drawCommandsData;
+        uint32_t _attributeMask = 0;
+    };
+    VSG_type_name(vsg::InstanceCulling);
+
+} // namespace vsg
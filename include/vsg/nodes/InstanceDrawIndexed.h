@@ -37,6 +37,10 @@ namespace vsg
         BufferInfoList arrays;
         ref_ptr<BufferInfo> indices;
 
+        /// optional DrawIndexedIndirectCommand, when assigned vkCmdDrawIndexedIndirect is used so that the instanceCount can be generated on the GPU.
+        /// Typically assigned by vsg::InstanceCulling, not serialized.
+        ref_ptr<BufferInfo> indirectCommand;
+
         void assignArrays(const DataList& in_arrays);
         void assignIndices(ref_ptr<Data> in_indices);
 
@@ -0,0 +1,50 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/nodes/Group.h>
+
+namespace vsg
+{
+
+    /// Occluder node provides a simplified, conservative triangle mesh that is rasterized into the RecordTraversal's OcclusionBuffer
+    /// when the View has an OcclusionBuffer assigned, enabling CullGroup, CullNode and LOD subgraphs that are hidden behind it to be culled.
+    /// The occluder mesh should lie entirely inside the geometry it represents. Occluders only hide nodes traversed after them,
+    /// so they should be placed early in the scene graph. The children of the Occluder are traversed as a normal Group.
+    class VSG_DECLSPEC Occluder : public Inherit<Group, Occluder>
+    {
+    public:
+        Occluder();
+        Occluder(const Occluder& rhs, const CopyOp& copyop = {});
+        Occluder(ref_ptr<vec3Array> in_vertices, ref_ptr<Data> in_indices);
+
+        /// occluder mesh vertices in the local coordinate frame
+        ref_ptr<vec3Array> vertices;
+
+        /// triangle list indices, ushortArray or uintArray, if null vertices are treated as a triangle list
+        ref_ptr<Data> indices;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return Occluder::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~Occluder();
+    };
+    VSG_type_name(vsg::Occluder);
+
+} // namespace vsg
@@ -16,6 +16,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/RenderGraph.h>
 #include <vsg/io/Logger.h>
 #include <vsg/lighting/Light.h>
+#include <vsg/maths/box.h>
 #include <vsg/nodes/Switch.h>
 #include <vsg/state/BindDescriptorSet.h>
 #include <vsg/state/DescriptorBuffer.h>
@@ -144,6 +145,29 @@ namespace vsg
         ref_ptr<BufferInfo> viewportDataBufferInfo;
 
         ref_ptr<Image> shadowDepthImage;
+        ref_ptr<Image> staticShadowDepthImage;
+
+        /// enable clustered light culling, point and spot lights are binned into a grid of view space clusters each frame so that
+        /// shaders compiled with VSG_CLUSTERED_LIGHTS only need to loop over the lights affecting the fragment's cluster.
+        /// Requires a ShaderSet with a "lightClusters" descriptor binding, see vsg::addLightClustersBinding(), and shaders that read it.
+        bool clusteredLighting = false;
+
+        /// number of clusters across the width, height and depth of the view frustum, depth slices are distributed logarithmically.
+        uivec3 lightClusterDimensions = uivec3(16, 9, 24);
+
+        /// maximum number of light indices across all clusters.
+        uint32_t maxLightClusterIndices = 65536;
+
+        /// intensity below which a point or spot light is treated as no longer contributing, used to compute each light's range of influence.
+        float lightClusterIntensityThreshold = 0.01f;
+
+        /// light cluster storage buffer layout, all values uint32_t :
+        ///   [0, 8) header : dimensions.x, dimensions.y, dimensions.z, numIndices, floatBits(near), floatBits(far), floatBits(sliceScale), floatBits(sliceBias)
+        ///   [8, 8 + 2 * numClusters) per cluster : offset, count
+        ///   [8 + 2 * numClusters, size) light indices : lightData index of the light, with bit 31 set for spot lights
+        /// where cluster = x + dimensions.x * (y + dimensions.y * z), and z = int(log(-eye_position.z) * sliceScale + sliceBias)
+        ref_ptr<uintArray> lightClusterData;
+        ref_ptr<BufferInfo> lightClusterDataBufferInfo;
 
         ref_ptr<DescriptorSetLayout> descriptorSetLayout;
         ref_ptr<DescriptorSet> descriptorSet;
@@ -161,6 +185,25 @@ namespace vsg
 
         virtual ref_ptr<ShadowSettings> getActiveShadowSettings(const Light* light) const;
 
+        /// cache the shadow maps of static shadow casters, a shadow map is only re-rendered when its light space camera changes
+        /// or it overlaps a region marked with dirtyShadowMaps(..). Must be set before the ViewDependentState is initialized.
+        bool shadowMapCaching = false;
+
+        /// traversal mask used when rendering static shadow casters into cached shadow maps.
+        Mask staticShadowCasterMask = 0x1;
+
+        /// traversal mask used when rendering dynamic shadow casters, when set these are rendered every frame on top of a copy of the cached static shadow map.
+        Mask dynamicShadowCasterMask = MASK_OFF;
+
+        /// fraction of a cascade's extents that its cached light space bounds are expanded by so that small camera movements don't require re-rendering.
+        double shadowMapCacheMargin = 0.25;
+
+        /// mark all the cached shadow maps as requiring re-rendering.
+        void dirtyShadowMaps();
+
+        /// mark the cached shadow maps that overlap the world space bounds as requiring re-rendering.
+        void dirtyShadowMaps(const dbox& worldBounds);
+
         // Shadow backend.
         bool compiled = false;
         ref_ptr<CommandGraph> preRenderCommandGraph;
@@ -170,12 +213,54 @@ namespace vsg
         {
             ref_ptr<RenderGraph> renderGraph;
             ref_ptr<View> view;
+
+            // cached static shadow casters, only used when shadowMapCaching and dynamicShadowCasterMask are set.
+            ref_ptr<Switch> staticSwitch;
+            ref_ptr<RenderGraph> staticRenderGraph;
+            ref_ptr<View> staticView;
+
+            // cache state
+            bool cacheValid = false;
+            dbox cachedBounds;
+            dmat4 cachedProjView;
+
+            // light space origin snapped to a grid near the view, so light space coordinates stay small at large world coordinates
+            dvec3 cachedEye;
+            double cachedEyeCellSize = 0.0;
+
+            // regions marked with dirtyShadowMaps(..) that haven't yet been tested against this shadow map
+            std::vector<dbox> dirtyRegions;
+            bool dirtyAll = false;
+
+            // projection used to cull the dynamic casters to the light space bounds of the view frustum, rather than the cached shadow map's bounds.
+            bool casterCulling = false;
+            dmat4 casterCullingProjectionMatrix;
         };
 
         mutable std::vector<ShadowMap> shadowMaps;
 
     protected:
         ~ViewDependentState();
+
+        struct ClusterLight
+        {
+            dvec3 eye_position;
+            double range = 0.0;
+            uint32_t index = 0;
+        };
+
+        mutable std::mutex _dirtyShadowRegionsMutex;
+        mutable std::vector<dbox> _dirtyShadowRegions;
+        mutable bool _dirtyAllShadowMaps = false;
+
+        /// check whether the cached shadow map is still valid for the specified light space projection and view matrix and its pending dirty regions, updating the cache state.
+        bool _shadowMapCacheValid(ShadowMap& shadowMap, const dmat4& projView) const;
+
+        mutable std::vector<ClusterLight> _clusterLights;
+        mutable std::vector<uint32_t> _clusterCapacities;
+
+        /// bin the _clusterLights into the lightClusterData
+        void assignLightClusters(const dmat4& projectionMatrix) const;
     };
     VSG_type_name(vsg::ViewDependentState);
 
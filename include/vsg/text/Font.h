@@ -12,14 +12,27 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/Array2D.h>
 #include <vsg/core/Data.h>
 #include <vsg/io/Options.h>
 #include <vsg/state/ImageInfo.h>
 #include <vsg/text/GlyphMetrics.h>
 #include <vsg/utils/SharedObjects.h>
 
+#include <set>
+
 namespace vsg
 {
+    /// GlyphSource rasterises glyphs on demand for a Font with a dynamic atlas, implemented by font loaders that retain access to the font face.
+    class VSG_DECLSPEC GlyphSource : public Inherit<Object, GlyphSource>
+    {
+    public:
+        /// create the glyph for charcode, returning false if the font has no glyph for it.
+        /// The image must match the atlas format with its first row at the top of the glyph, metrics.uvrect is assigned by Font.
+        virtual bool createGlyph(uint32_t charcode, GlyphMetrics& metrics, ref_ptr<ubyteArray2D>& image) = 0;
+    };
+    VSG_type_name(vsg::GlyphSource);
+
     class VSG_DECLSPEC Font : public Inherit<Object, Font>
     {
     public:
@@ -34,20 +47,76 @@ namespace vsg
 
         ref_ptr<Data> atlas;
         ref_ptr<GlyphMetricsArray> glyphMetrics;
+
+        /// dense charmap indexed directly by charcode, as assigned by font loaders and read from files.
+        /// When assigned it's used in preference to the sparse charmap pages.
         ref_ptr<uintArray> charmap;
+
+        /// sparse charmap made up of fixed size pages of glyph indices, only the pages that contain glyphs are stored.
+        /// charmapPageIndex[charcode >> charmapPageShift] is 0 when the page has no glyphs, otherwise 1 + the page number within charmapPages.
+        /// Assigned by compactCharmap(), or by addGlyphs() when no dense charmap is assigned.
+        ref_ptr<uintArray> charmapPageIndex;
+        ref_ptr<uintArray> charmapPages;
+        static constexpr uint32_t charmapPageShift = 7;
+        static constexpr uint32_t charmapPageSize = 1 << charmapPageShift;
+
         ref_ptr<SharedObjects> sharedObjects;
         ref_ptr<ImageInfo> atlasImageInfo;
         ref_ptr<ImageInfo> glyphImageInfo;
 
         /// get the index into the glyphMetrics array for the glyph associated with specified charcode
+        /// the dense charmap takes precedence when assigned, so reassigning it after compacting isn't masked by stale pages.
         uint32_t glyphIndexForCharcode(uint32_t charcode) const
         {
-            if (charmap && charcode < charmap->size()) return charmap->at(charcode);
+            if (charmap) return (charcode < charmap->size()) ? charmap->at(charcode) : 0;
+
+            if (charmapPageIndex)
+            {
+                uint32_t page = charcode >> charmapPageShift;
+                if (page >= charmapPageIndex->size()) return 0;
+
+                uint32_t pageNumber = charmapPageIndex->at(page);
+                if (pageNumber == 0) return 0;
+
+                return charmapPages->at(((pageNumber - 1) << charmapPageShift) | (charcode & (charmapPageSize - 1)));
+            }
+
             return 0;
         }
+
+        /// compact the dense charmap into charmapPageIndex/charmapPages and release the dense charmap, reducing the memory used by fonts with
+        /// glyphs spread over a large charcode range such as CJK fonts. Note, charmap is null afterwards, use createDenseCharmap() or glyphIndexForCharcode() to access the mapping.
+        void compactCharmap();
+
+        /// create a dense charmap from the sparse charmap pages, or return the dense charmap if it's still assigned.
+        ref_ptr<uintArray> createDenseCharmap() const;
+
         void createFontImages();
 
+        /// source of glyphs added to the atlas on demand by addGlyphs(), when null the font is limited to the glyphs it was created with.
+        ref_ptr<GlyphSource> glyphSource;
+
+        /// reserve space for numGlyphs additional glyphs in glyphMetrics and atlasRows additional rows at the bottom of the atlas for use by addGlyphs().
+        /// The atlas and glyphMetrics are given DYNAMIC_DATA dataVariance so that the glyphs added later are transferred by TransferTask.
+        /// Must be called before createFontImages()/Text::setup(), as the GPU images are allocated to the reserved size. Only ubyteArray2D atlases are supported.
+        bool reserveGlyphs(uint32_t numGlyphs, uint32_t atlasRows);
+
+        /// add the glyphs required by text that aren't yet in the font, rasterised by glyphSource and packed into the space reserved by reserveGlyphs().
+        /// Called by Text::setup() and TextGroup::setup(), must not be called while another thread is laying out text with this font. Returns the number of glyphs added.
+        uint32_t addGlyphs(const Data& text);
+
+        /// add the glyph for charcode if it's not already in the font, returning its glyph index or 0 if it's unavailable.
+        uint32_t addGlyph(uint32_t charcode);
+
     protected:
+        void _assignGlyphIndex(uint32_t charcode, uint32_t glyphIndex);
+
+        // glyph space reserved by reserveGlyphs(), filled row by row as glyphs are added
+        uint32_t _nextGlyphIndex = 0;
+        uint32_t _shelfX = 0;
+        uint32_t _shelfY = 0;
+        uint32_t _shelfHeight = 0;
+        std::set<uint32_t> _unavailableCharcodes;
     };
     VSG_type_name(vsg::Font);
 
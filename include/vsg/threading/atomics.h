@@ -17,20 +17,22 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 namespace vsg
 {
 
-    /// Convenience template function that sets the value of an atomic if the passed in value is less than the value of the atomic.
+    /// Convenience template function that sets the value of an atomic if the passed in value is less than the value of the atomic, returns true if the atomic was modified.
     template<typename T>
-    void exchange_if_lower(std::atomic<T>& reference, T t)
+    bool exchange_if_lower(std::atomic<T>& reference, T t)
     {
         T original_value = reference.load();
         while (t < original_value && !reference.compare_exchange_weak(original_value, t)) {}
+        return t < original_value;
     };
 
-    /// Convenience template function that sets the value of an atomic if the passed in value is greater than the value of the atomic.
+    /// Convenience template function that sets the value of an atomic if the passed in value is greater than the value of the atomic, returns true if the atomic was modified.
     template<typename T>
-    void exchange_if_greater(std::atomic<T>& reference, T t)
+    bool exchange_if_greater(std::atomic<T>& reference, T t)
     {
         T original_value = reference.load();
         while (t > original_value && !reference.compare_exchange_weak(original_value, t)) {}
+        return t > original_value;
     };
 
     /// Convenience template function that multiplies the value of an atomic by specified value
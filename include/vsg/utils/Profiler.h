@@ -17,8 +17,14 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/ui/FrameStamp.h>
 #include <vsg/utils/Instrumentation.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace vsg
 {
+    /// ProfileLog records enter/leave entries into per thread rings without contention between threads,
+    /// merging the completed entries into the shared entries ring at frame boundaries via mergeThreadLogs().
     class VSG_DECLSPEC ProfileLog : public Inherit<Object, ProfileLog>
     {
     public:
@@ -45,54 +51,96 @@ namespace vsg
             std::thread::id thread_id = {};
         };
 
+        /// rolling statistics of the cpu durations, in milliseconds, of a SourceLocation
+        struct Statistics
+        {
+            uint64_t count = 0;
+            double mean = 0.0;
+            double p50 = 0.0;
+            double p95 = 0.0;
+            double p99 = 0.0;
+            double max = 0.0;
+        };
+
         std::map<std::thread::id, std::string> threadNames;
         std::vector<Entry> entries;
         std::atomic_uint64_t index = 0;
         std::vector<uint64_t> frameIndices;
         double timestampScaleToMilliseconds = 1e-6;
 
-        Entry& enter(uint64_t& reference, Type type)
-        {
-            reference = index.fetch_add(1);
-            Entry& enter_entry = entry(reference);
-            enter_entry.enter = true;
-            enter_entry.type = type;
-            enter_entry.reference = 0;
-            enter_entry.cpuTime = clock::now();
-            enter_entry.gpuTime = 0;
-            enter_entry.thread_id = std::this_thread::get_id();
-            return enter_entry;
-        }
-
-        Entry& leave(uint64_t& reference, Type type)
-        {
-            Entry& enter_entry = entry(reference);
-
-            uint64_t new_reference = index.fetch_add(1);
-            Entry& leave_entry = entry(new_reference);
-
-            enter_entry.reference = new_reference;
-            leave_entry.cpuTime = clock::now();
-            leave_entry.gpuTime = 0;
-            leave_entry.enter = false;
-            leave_entry.type = type;
-            leave_entry.reference = reference;
-            leave_entry.thread_id = std::this_thread::get_id();
-            reference = new_reference;
-            return leave_entry;
-        }
-
-        Entry& entry(uint64_t reference)
-        {
-            return entries[reference % entries.size()];
-        }
+        /// number of recent durations per SourceLocation used to compute the Statistics.
+        uint32_t statisticsWindowSize = 256;
+
+        /// references returned by enter()/leave() with this bit set refer to the calling thread's ring, rather than the shared entries.
+        static constexpr uint64_t threadReferenceShift = 48;
+        static constexpr uint64_t localReferenceMask = (uint64_t(1) << threadReferenceShift) - 1;
+
+        /// record enter entry in the calling thread's ring, assigning reference to pass to the matching leave() call on the same thread.
+        /// If the ring is full of entries not yet merged the entry is discarded and reference set to 0.
+        Entry& enter(uint64_t& reference, Type type, const SourceLocation* sourceLocation = nullptr, const Object* object = nullptr);
+
+        /// record leave entry in the calling thread's ring, linking it to the enter entry, assigns reference to the leave entry.
+        Entry& leave(uint64_t& reference, Type type, const SourceLocation* sourceLocation = nullptr, const Object* object = nullptr);
+
+        /// return entry for a reference, thread references are resolved to the shared entries once merged.
+        Entry& entry(uint64_t reference);
+
+        /// convert thread reference to the index into the shared entries, returns the reference unchanged if it's not yet merged.
+        uint64_t sharedReference(uint64_t reference);
+
+        /// merge the entries written by all threads into the shared entries in time order and update the rolling statistics.
+        /// Enter entries of spans still open are merged too, with the link to their leave entry assigned when it's merged. Called by Profiler at the end of each frame.
+        void mergeThreadLogs();
+
+        /// thread safe query of the rolling statistics for a SourceLocation.
+        Statistics statistics(const SourceLocation* sourceLocation) const;
+
+        /// thread safe query of the rolling statistics for all SourceLocations.
+        std::map<const SourceLocation*, Statistics> statistics() const;
 
         void report(std::ostream& out);
         uint64_t report(std::ostream& out, uint64_t reference);
 
+        /// write the merged entries as Chrome trace event JSON, viewable in chrome://tracing and ui.perfetto.dev.
+        /// CPU spans are written per thread, GPU spans on a separate GPU track and frames as global instant events.
+        void writeTraceEvents(std::ostream& out);
+
     public:
         void read(Input& input) override;
         void write(Output& output) const override;
+
+    protected:
+        struct ThreadLog
+        {
+            std::thread::id thread_id;
+            uint64_t threadIndex = 0;
+            std::vector<Entry> entries;
+            std::vector<uint64_t> sharedReferences;
+            uint64_t next = 0;                 // only accessed by the owning thread
+            uint64_t depth = 0;                // only accessed by the owning thread
+            Entry discarded;                   // returned by enter()/leave() when the ring is full
+            std::atomic_uint64_t written = 0;  // published by the owning thread
+            std::atomic_uint64_t merged = 0;   // published by the merging thread
+            std::vector<uint64_t> openSpans;   // shared indices of merged enter entries whose leave entry isn't merged yet, only accessed by mergeThreadLogs()
+        };
+
+        ThreadLog& _threadLog();
+        ThreadLog* _threadLog(uint64_t reference);
+        void _addDuration(const SourceLocation* sourceLocation, double duration);
+
+        const uint64_t _logID;
+        std::mutex _mergeMutex;
+        std::mutex _threadLogsMutex;
+        std::vector<std::unique_ptr<ThreadLog>> _threadLogs;
+
+        struct Durations
+        {
+            std::vector<double> values;
+            uint64_t count = 0;
+        };
+
+        mutable std::mutex _statisticsMutex;
+        std::map<const SourceLocation*, Durations> _durations;
     };
     VSG_type_name(ProfileLog);
 
@@ -4,6 +4,7 @@
 #include <vsg/io/FileSystem.h>
 #include <vsg/io/Options.h>
 #include <vsg/state/ShaderStage.h>
+#include <vsg/utils/SpirvCache.h>
 
 namespace vsg
 {
@@ -25,6 +26,10 @@ namespace vsg
         // default ShaderCompileSettings
         ref_ptr<ShaderCompileSettings> defaults;
 
+        /// cache of previously compiled SPIR-V, defaults to SpirvCache::instance(), set to null to always compile.
+        /// When Options::fileCache is set compiled SPIR-V is also cached on disk in its spirv subdirectory.
+        ref_ptr<SpirvCache> spirvCache;
+
         bool compile(ShaderStages& shaders, const std::vector<std::string>& defines = {}, ref_ptr<const Options> options = {});
         bool compile(ref_ptr<ShaderStage> shaderStage, const std::vector<std::string>& defines = {}, ref_ptr<const Options> options = {});
 
@@ -37,6 +42,8 @@ namespace vsg
 
     protected:
         bool _initialized = false;
+
+        bool _compile(ShaderStages& shaders, const std::vector<std::string>& finalShaderSources);
     };
     VSG_type_name(vsg::ShaderCompiler);
 
@@ -203,6 +203,11 @@ namespace vsg
     };
     VSG_type_name(vsg::ShaderSet);
 
+    /// add the "lightClusters" storage buffer binding, enabled by the VSG_CLUSTERED_LIGHTS define, to the view descriptor set of a lit ShaderSet.
+    /// Used in conjunction with ViewDependentState::clusteredLighting and shaders that loop over the lights of each fragment's cluster when VSG_CLUSTERED_LIGHTS is defined.
+    /// The standard ShaderSets don't read the light clusters so the binding isn't added to them.
+    extern VSG_DECLSPEC void addLightClustersBinding(ShaderSet& shaderSet);
+
     /// create a ShaderSet for unlit, flat shaded rendering
     extern VSG_DECLSPEC ref_ptr<ShaderSet> createFlatShadedShaderSet(ref_ptr<const Options> options = {});
 
@@ -12,14 +12,17 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/Data.h>
 #include <vsg/core/Inherit.h>
 #include <vsg/core/compare.h>
 #include <vsg/io/stream.h>
 
+#include <array>
 #include <map>
 #include <mutex>
 #include <ostream>
 #include <set>
+#include <unordered_map>
 
 namespace vsg
 {
@@ -28,6 +31,8 @@ namespace vsg
     class SuitableForSharing;
 
     /// class for facilitating the sharing of instances of objects that have the same properties.
+    /// Shared objects are indexed by a structural hash so that Object::compare() is only required when hashes match,
+    /// with the index split into shards that each have their own mutex so that threads sharing different objects rarely contend.
     class VSG_DECLSPEC SharedObjects : public Inherit<Object, SharedObjects>
     {
     public:
@@ -72,12 +77,48 @@ namespace vsg
         /// write out stats of objects held, types of objects and their reference counts
         void report(vsg::LogOutput& output);
 
+        /// compute the structural hash of an object, objects that compare as equal have the same hash.
+        /// Data and Image are hashed from the members they compare, other objects from the values they serialize via Object::write(Output&).
+        /// Types that serialize none of their members hash to a value that only depends on their type.
+        uint64_t hash(const Object* object) const;
+
+        static constexpr size_t numShards = 16;
+
     protected:
         virtual ~SharedObjects();
 
+        /// return the shared object that matches object, if none is found then object is inserted when insert is true
+        ref_ptr<Object> _findOrInsert(ref_ptr<Object> object, const std::type_index& id, bool insert);
+
+        /// compute the hash of object, returning false if it only depends on the type, in which case object is held in an ordered set rather than by hash
+        bool _hash(const Object* object, uint64_t& value) const;
+
+        /// get the hash computed when object was inserted, return false if object isn't held or is Data that has since been modified
+        bool _getCachedHash(const Object* object, uint64_t& value) const;
+
+        struct Shard
+        {
+            std::mutex mutex;
+            std::map<std::type_index, std::unordered_multimap<uint64_t, ref_ptr<Object>>> objects;
+            std::map<std::type_index, std::set<ref_ptr<Object>, DereferenceLess>> orderedObjects;
+        };
+
+        struct CachedHash
+        {
+            uint64_t hash = 0;
+            ModifiedCount modifiedCount;
+        };
+
         mutable std::recursive_mutex _mutex;
         std::map<std::type_index, ref_ptr<Object>> _defaults;
-        std::map<std::type_index, std::set<ref_ptr<Object>, DereferenceLess>> _sharedObjects;
+        std::set<ref_ptr<Object>, DereferenceLess> _loadedObjects;
+
+        std::array<Shard, numShards> _shards;
+
+        mutable std::mutex _hashCacheMutex;
+        std::unordered_map<const Object*, CachedHash> _hashCache;
+
+        friend class SharedObjectsHashOutput;
     };
     VSG_type_name(vsg::SharedObjects);
 
@@ -134,17 +175,7 @@ namespace vsg
         auto def_T = def.cast<T>(); // should be able to do a static cast
         if (!def_T)
         {
-            def_T = T::create();
-            auto& shared_objects = _sharedObjects[id];
-            if (auto itr = shared_objects.find(def_T); itr != shared_objects.end())
-            {
-                def_T = (static_cast<T*>(itr->get()));
-            }
-            else
-            {
-                shared_objects.insert(def_T);
-            }
-
+            def_T = ref_ptr<T>(static_cast<T*>(_findOrInsert(T::create(), id, true).get()));
             def = def_T;
         }
 
@@ -155,48 +186,38 @@ namespace vsg
     template<class T>
     void SharedObjects::share(ref_ptr<T>& object)
     {
-        std::scoped_lock<std::recursive_mutex> lock(_mutex);
-
-        if (suitableForSharing && !suitableForSharing->suitable(object.get())) return;
+        if (!object) return;
 
-        auto id = std::type_index(typeid(T));
-        auto& shared_objects = _sharedObjects[id];
-        if (auto itr = shared_objects.find(object); itr != shared_objects.end())
+        if (suitableForSharing)
         {
-            object = ref_ptr<T>(static_cast<T*>(itr->get()));
-            return;
+            std::scoped_lock<std::recursive_mutex> lock(_mutex);
+            if (!suitableForSharing->suitable(object.get())) return;
         }
 
-        shared_objects.insert(object);
+        object = ref_ptr<T>(static_cast<T*>(_findOrInsert(object, std::type_index(typeid(T)), true).get()));
     }
 
     // implementation of template method
     template<class T, typename Func>
     void SharedObjects::share(ref_ptr<T>& object, Func init)
     {
+        auto id = std::type_index(typeid(T));
+        if (auto existing = _findOrInsert(object, id, false))
         {
-            std::scoped_lock<std::recursive_mutex> lock(_mutex);
-
-            auto id = std::type_index(typeid(T));
-            auto& shared_objects = _sharedObjects[id];
-            if (auto itr = shared_objects.find(object); itr != shared_objects.end())
-            {
-                object = ref_ptr<T>(static_cast<T*>(itr->get()));
-                return;
-            }
+            object = ref_ptr<T>(static_cast<T*>(existing.get()));
+            return;
         }
 
         init(object);
 
+        bool suitable = true;
+        if (suitableForSharing)
         {
             std::scoped_lock<std::recursive_mutex> lock(_mutex);
-            auto id = std::type_index(typeid(T));
-            auto& shared_objects = _sharedObjects[id];
-            if (suitableForSharing && suitableForSharing->suitable(object.get()))
-            {
-                shared_objects.insert(object);
-            }
+            suitable = suitableForSharing->suitable(object.get());
         }
+
+        if (suitable) _findOrInsert(object, id, true);
     }
 
     // implementation of template method
@@ -0,0 +1,129 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Path.h>
+#include <vsg/state/ShaderModule.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace vsg
+{
+
+    /// SpirvCache provides a content addressed cache of the SPIR-V generated by ShaderCompiler, held in memory and optionally on disk.
+    /// Entries are keyed by a hash of everything that affects the compiled result, i.e. the stages, the final shader source with includes and defines
+    /// applied, and the ShaderCompileSettings. Concurrent compiles of the same key are deduplicated, with later threads waiting for the first to complete.
+    class VSG_DECLSPEC SpirvCache : public Inherit<Object, SpirvCache>
+    {
+    public:
+        SpirvCache();
+
+        /// shared SpirvCache used by ShaderCompiler by default
+        static ref_ptr<SpirvCache>& instance();
+
+        using Key = std::pair<uint64_t, uint64_t>;
+        using Entry = std::vector<ShaderModule::SPIRV>;
+
+        /// incremental 128 bit hash used to compute keys
+        struct VSG_DECLSPEC Hash
+        {
+            uint64_t first = 14695981039346656037ull;
+            uint64_t second = 0x9E3779B97F4A7C15ull;
+
+            void add(const void* ptr, size_t size);
+            void add(const std::string& str);
+
+            template<typename T>
+            void add(T value)
+            {
+                static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Hash::add(T) only supports arithmetic and enum types");
+                add(&value, sizeof(T));
+            }
+
+            Key key() const { return {first, second}; }
+        };
+
+        struct Statistics
+        {
+            uint64_t memoryHits = 0;
+            uint64_t fileHits = 0;
+            uint64_t misses = 0;
+            uint64_t waits = 0;
+        };
+
+        /// look up entry in memory then in directory, returning true on a hit.
+        /// On a miss the key is marked as pending and the caller must call add() or release() once it has compiled the shaders,
+        /// with other threads acquiring the same key waiting until then.
+        bool acquire(const Key& key, Entry& entry, const Path& directory = {});
+
+        /// add compiled entry to the cache, writing it to directory if one is specified, and release any threads waiting on the key.
+        void add(const Key& key, const Entry& entry, const Path& directory = {});
+
+        /// release a pending key without adding an entry, used when compilation fails.
+        void release(const Key& key);
+
+        /// remove all the entries held in memory
+        void clear();
+
+        /// maximum number of entries held in memory, once exceeded the oldest entries are discarded. Entries written to disk are unaffected.
+        size_t maxMemoryEntries = 1024;
+
+        Statistics getStatistics() const;
+
+        /// return hexadecimal string of key, used as the filename of entries written to disk
+        static std::string toString(const Key& key);
+
+    protected:
+        virtual ~SpirvCache();
+
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        void _insert(const Key& key, const Entry& entry);
+
+        std::map<Key, Entry> _entries;
+        std::deque<Key> _insertionOrder;
+        std::set<Key> _pending;
+        Statistics _statistics;
+    };
+    VSG_type_name(vsg::SpirvCache);
+
+    /// PendingSpirv releases a key acquired from SpirvCache::acquire() on destruction unless it has been added to the cache,
+    /// ensuring threads waiting on the key are woken even if compilation fails or throws.
+    class PendingSpirv
+    {
+    public:
+        PendingSpirv(SpirvCache* in_cache, const SpirvCache::Key& in_key) :
+            cache(in_cache), key(in_key) {}
+        PendingSpirv(const PendingSpirv&) = delete;
+        PendingSpirv& operator=(const PendingSpirv&) = delete;
+
+        ~PendingSpirv()
+        {
+            if (cache) cache->release(key);
+        }
+
+        void add(const SpirvCache::Entry& entry, const Path& directory)
+        {
+            if (cache) cache->add(key, entry, directory);
+            cache = nullptr;
+        }
+
+        SpirvCache* cache = nullptr;
+        SpirvCache::Key key;
+    };
+
+} // namespace vsg
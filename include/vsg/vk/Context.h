@@ -30,6 +30,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/DescriptorPool.h>
 #include <vsg/vk/Fence.h>
 #include <vsg/vk/MemoryBufferPools.h>
+#include <vsg/vk/PipelineCache.h>
 #include <vsg/vk/ResourceRequirements.h>
 
 namespace vsg
@@ -112,6 +113,9 @@ namespace vsg
         // ShaderCompiler
         ref_ptr<ShaderCompiler> shaderCompiler;
 
+        /// PipelineCache used when creating pipelines, defaults to Device::pipelineCache
+        ref_ptr<PipelineCache> pipelineCache;
+
         /// Hook for assigning Instrumentation to enable profiling
         ref_ptr<Instrumentation> instrumentation;
 
@@ -26,6 +26,7 @@ namespace vsg
     class MemoryBufferPools;
     class DescriptorPools;
     class TransferTask;
+    class PipelineCache;
 
     struct QueueSetting
     {
@@ -94,6 +95,10 @@ namespace vsg
         observer_ptr<DescriptorPools> descriptorPools;
         observer_ptr<TransferTask> transferTask;
 
+        /// PipelineCache used when creating pipelines for this device, picked up by Context on construction.
+        /// Owned by the Device, and released, writing it to its file if one is assigned, before the VkDevice is destroyed.
+        ref_ptr<PipelineCache> pipelineCache;
+
     protected:
         virtual ~Device();
 
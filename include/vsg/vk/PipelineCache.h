@@ -0,0 +1,68 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Path.h>
+#include <vsg/vk/Device.h>
+
+#include <mutex>
+
+namespace vsg
+{
+
+    /// PipelineCache encapsulates VkPipelineCache, enabling pipeline compilation results to be reused across pipelines and across application runs.
+    /// When a filename is assigned the cache is initialized from the file, provided the file was written for the same device, driver version and
+    /// pipeline cache UUID, and the cache contents are written back to the file when the PipelineCache is released or destroyed.
+    /// Assign to Device::pipelineCache prior to compiling the scene graph so that the Context used by CompileTraversal picks it up, the Device then
+    /// owns the PipelineCache and releases it before the VkDevice is destroyed.
+    class VSG_DECLSPEC PipelineCache : public Inherit<Object, PipelineCache>
+    {
+    public:
+        explicit PipelineCache(Device* device, const Path& in_filename = {});
+
+        operator VkPipelineCache() const { return _pipelineCache; }
+        VkPipelineCache vk() const { return _pipelineCache; }
+
+        Device* getDevice() { return _device; }
+        const Device* getDevice() const { return _device; }
+
+        /// file that the cache is read from on construction and written to on destruction
+        const Path filename;
+
+        /// get the current contents of the VkPipelineCache
+        std::vector<uint8_t> getData() const;
+
+        /// write cache contents to filename, return true on success
+        bool write() const { return write(filename); }
+
+        /// write cache contents to specified file, return true on success. The contents are written to a temporary file that is then renamed,
+        /// so an interrupted write doesn't leave a truncated file.
+        bool write(const Path& in_filename) const;
+
+        /// write the cache contents to filename if assigned, and destroy the VkPipelineCache. Called by the Device before it's destroyed.
+        void release();
+
+    protected:
+        virtual ~PipelineCache();
+
+        bool _read(std::vector<uint8_t>& data) const;
+
+        VkPipelineCache _pipelineCache;
+
+        // not a ref_ptr<> as the Device owns the PipelineCache, set to null when released
+        Device* _device;
+        mutable std::mutex _mutex;
+    };
+    VSG_type_name(vsg::PipelineCache);
+
+} // namespace vsg
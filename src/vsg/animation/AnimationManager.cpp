@@ -11,6 +11,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/animation/AnimationManager.h>
+#include <vsg/threading/Latch.h>
 
 using namespace vsg;
 
@@ -75,15 +76,82 @@ bool AnimationManager::update(vsg::Animation& animation)
     return animation.update(_simulationTime);
 }
 
+void AnimationManager::_updateAnimations(size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        _updateResults[i] = update(*_updateAnimationList[i]) ? 1 : 0;
+    }
+}
+
 void AnimationManager::run(vsg::ref_ptr<vsg::FrameStamp> frameStamp)
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "AnimationManager run animation updates", COLOR_VIEWER);
 
     _simulationTime = frameStamp->simulationTime;
 
-    for (auto itr = animations.begin(); itr != animations.end();)
+    if (numUpdateThreads <= 1 || animations.size() < minimumAnimationsForParallelUpdate)
+    {
+        for (auto itr = animations.begin(); itr != animations.end();)
+        {
+            if (update(**itr))
+                ++itr;
+            else
+            {
+                itr = animations.erase(itr);
+            }
+        }
+        return;
+    }
+
+    // calling thread takes part in the updates so only create the additional threads
+    uint32_t numAdditionalThreads = numUpdateThreads - 1;
+    if (!_operationThreads || _operationThreads->threads.size() != numAdditionalThreads)
+    {
+        _operationThreads = OperationThreads::create(numAdditionalThreads);
+    }
+
+    _updateAnimationList.clear();
+    for (auto& animation : animations) _updateAnimationList.push_back(animation.get());
+    _updateResults.assign(_updateAnimationList.size(), 0);
+
+    struct UpdateAnimationsOperation : public Operation
+    {
+        UpdateAnimationsOperation(AnimationManager* am, size_t b, size_t e, ref_ptr<Latch> l) :
+            animationManager(am), begin(b), end(e), latch(l) {}
+
+        AnimationManager* animationManager;
+        size_t begin;
+        size_t end;
+        ref_ptr<Latch> latch;
+
+        void run() override
+        {
+            animationManager->_updateAnimations(begin, end);
+            latch->count_down();
+        }
+    };
+
+    // split into a few batches per thread so that animations with differing costs balance out across the threads
+    size_t numAnimations = _updateAnimationList.size();
+    size_t numBatches = std::min(numAnimations, static_cast<size_t>(numUpdateThreads) * 4);
+    size_t batchSize = (numAnimations + numBatches - 1) / numBatches;
+    numBatches = (numAnimations + batchSize - 1) / batchSize;
+
+    auto latch = Latch::create(numBatches);
+    for (size_t begin = 0; begin < numAnimations; begin += batchSize)
+    {
+        _operationThreads->add(ref_ptr<Operation>(new UpdateAnimationsOperation(this, begin, std::min(begin + batchSize, numAnimations), latch)));
+    }
+
+    _operationThreads->run();
+    latch->wait();
+
+    // remove the animations that have finished, preserving the order of the remaining ones
+    size_t i = 0;
+    for (auto itr = animations.begin(); itr != animations.end(); ++i)
     {
-        if (update(**itr))
+        if (_updateResults[i])
             ++itr;
         else
         {
@@ -0,0 +1,359 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/animation/ComputeSkinning.h>
+#include <vsg/core/Exception.h>
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/Context.h>
+
+using namespace vsg;
+
+namespace
+{
+    // attributeMask bits
+    constexpr uint32_t NORMALS_BIT = 1 << 0;
+
+    // Vulkan guarantees minStorageBufferOffsetAlignment is no larger than 256
+    constexpr VkDeviceSize storageBufferAlignment = 256;
+
+    // layout must match the push_constant block in the compute shader.
+    struct PushConstants
+    {
+        uint32_t vertexCount;
+        uint32_t jointCount;
+        uint32_t attributeMask;
+        uint32_t padding;
+    };
+
+    const char* computeSkinning_comp = R"(#version 450
+
+layout(local_size_x = 64) in;
+
+layout(push_constant) uniform PushConstants {
+    uint vertexCount;
+    uint jointCount;
+    uint attributeMask;
+    uint padding;
+} pc;
+
+layout(std430, set = 0, binding = 0) readonly buffer SourceVertices { float sourceVertices[]; };
+layout(std430, set = 0, binding = 1) readonly buffer SourceNormals { float sourceNormals[]; };
+layout(std430, set = 0, binding = 2) readonly buffer JointIndices { uvec4 jointIndices[]; };
+layout(std430, set = 0, binding = 3) readonly buffer JointWeights { vec4 jointWeights[]; };
+layout(std430, set = 0, binding = 4) readonly buffer JointMatrices { mat4 jointMatrices[]; };
+layout(std430, set = 0, binding = 5) writeonly buffer Vertices { float vertices[]; };
+layout(std430, set = 0, binding = 6) writeonly buffer Normals { float normals[]; };
+
+void main()
+{
+    uint v = gl_GlobalInvocationID.x;
+    if (v >= pc.vertexCount) return;
+
+    // each row of workgroups skins one instance using its palette within the packed joint matrices
+    uint instance = gl_GlobalInvocationID.y;
+    uvec4 joints = jointIndices[v] + uvec4(instance * pc.jointCount);
+    vec4 weights = jointWeights[v];
+
+    mat4 skinMatrix = weights.x * jointMatrices[joints.x] +
+                      weights.y * jointMatrices[joints.y] +
+                      weights.z * jointMatrices[joints.z] +
+                      weights.w * jointMatrices[joints.w];
+
+    uint src = v * 3;
+    uint dst = (instance * pc.vertexCount + v) * 3;
+
+    vec3 vertex = (skinMatrix * vec4(sourceVertices[src], sourceVertices[src + 1], sourceVertices[src + 2], 1.0)).xyz;
+    vertices[dst] = vertex.x;
+    vertices[dst + 1] = vertex.y;
+    vertices[dst + 2] = vertex.z;
+
+    if ((pc.attributeMask & 1) != 0)
+    {
+        vec3 normal = normalize(mat3(skinMatrix) * vec3(sourceNormals[src], sourceNormals[src + 1], sourceNormals[src + 2]));
+        normals[dst] = normal.x;
+        normals[dst + 1] = normal.y;
+        normals[dst + 2] = normal.z;
+    }
+}
+)";
+
+    template<typename T>
+    ref_ptr<Data> convertJointIndices(const T& indices)
+    {
+        auto converted = uivec4Array::create(indices.size());
+        auto dest_itr = converted->begin();
+        for (const auto& index : indices)
+        {
+            *(dest_itr++) = uivec4(index.x, index.y, index.z, index.w);
+        }
+        return converted;
+    }
+} // namespace
+
+ComputeSkinning::ComputeSkinning()
+{
+}
+
+ComputeSkinning::ComputeSkinning(const ComputeSkinning& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    vertices(copyop(rhs.vertices)),
+    normals(copyop(rhs.normals)),
+    jointIndices(copyop(rhs.jointIndices)),
+    jointWeights(copyop(rhs.jointWeights)),
+    jointCount(rhs.jointCount),
+    instanceCount(rhs.instanceCount),
+    jointMatrices(copyop(rhs.jointMatrices))
+{
+}
+
+ComputeSkinning::ComputeSkinning(ref_ptr<vec3Array> in_vertices, ref_ptr<vec3Array> in_normals, ref_ptr<Data> in_jointIndices, ref_ptr<vec4Array> in_jointWeights, uint32_t in_jointCount, uint32_t in_instanceCount) :
+    vertices(in_vertices),
+    normals(in_normals),
+    jointIndices(in_jointIndices),
+    jointWeights(in_jointWeights),
+    jointCount(in_jointCount),
+    instanceCount(in_instanceCount)
+{
+    _setUp();
+}
+
+ComputeSkinning::~ComputeSkinning()
+{
+}
+
+int ComputeSkinning::compare(const Object& rhs_object) const
+{
+    int result = Command::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_pointer(vertices, rhs.vertices)) != 0) return result;
+    if ((result = compare_pointer(normals, rhs.normals)) != 0) return result;
+    if ((result = compare_pointer(jointIndices, rhs.jointIndices)) != 0) return result;
+    if ((result = compare_pointer(jointWeights, rhs.jointWeights)) != 0) return result;
+    if ((result = compare_value(jointCount, rhs.jointCount)) != 0) return result;
+    if ((result = compare_value(instanceCount, rhs.instanceCount)) != 0) return result;
+    return compare_pointer(jointMatrices, rhs.jointMatrices);
+}
+
+void ComputeSkinning::read(Input& input)
+{
+    Command::read(input);
+
+    input.read("vertices", vertices);
+    input.read("normals", normals);
+    input.read("jointIndices", jointIndices);
+    input.read("jointWeights", jointWeights);
+    input.read("jointCount", jointCount);
+    input.read("instanceCount", instanceCount);
+    input.read("jointMatrices", jointMatrices);
+
+    _setUp();
+}
+
+void ComputeSkinning::write(Output& output) const
+{
+    Command::write(output);
+
+    output.write("vertices", vertices);
+    output.write("normals", normals);
+    output.write("jointIndices", jointIndices);
+    output.write("jointWeights", jointWeights);
+    output.write("jointCount", jointCount);
+    output.write("instanceCount", instanceCount);
+    output.write("jointMatrices", jointMatrices);
+}
+
+ref_ptr<mat4Array> ComputeSkinning::instanceJointMatrices(uint32_t instance)
+{
+    _setUp();
+    return instance < _instanceJointMatrices.size() ? _instanceJointMatrices[instance] : ref_ptr<mat4Array>{};
+}
+
+ref_ptr<BufferInfo> ComputeSkinning::skinnedVertices(uint32_t instance)
+{
+    _setUp();
+    if (!_skinnedBuffer || instance >= instanceCount) return {};
+
+    VkDeviceSize size = vertices->dataSize();
+    return BufferInfo::create(_skinnedBuffer, instance * size, size);
+}
+
+ref_ptr<BufferInfo> ComputeSkinning::skinnedNormals(uint32_t instance)
+{
+    _setUp();
+    if (!_skinnedBuffer || (_attributeMask & NORMALS_BIT) == 0 || instance >= instanceCount) return {};
+
+    VkDeviceSize size = normals->dataSize();
+    return BufferInfo::create(_skinnedBuffer, _skinnedNormalsOffset + instance * size, size);
+}
+
+void ComputeSkinning::_setUp()
+{
+    if (_bindComputePipeline) return;
+
+    if (!vertices || !jointIndices || !jointWeights || jointCount == 0 || instanceCount == 0) return;
+
+    uint32_t vertexCount = static_cast<uint32_t>(vertices->size());
+    if (jointIndices->valueCount() != vertexCount || jointWeights->size() != vertexCount)
+    {
+        warn("ComputeSkinning::_setUp() jointIndices and jointWeights must have one entry per vertex.");
+        return;
+    }
+
+    bool skinNormals = normals.valid();
+    if (skinNormals && normals->size() != vertexCount)
+    {
+        warn("ComputeSkinning::_setUp() normals must have one entry per vertex, ignoring normals.");
+        skinNormals = false;
+    }
+
+    // the compute shader reads the joint indices as uvec4, so convert narrower index types
+    ref_ptr<Data> indices = jointIndices;
+    if (auto usIndices = jointIndices.cast<usvec4Array>())
+        indices = convertJointIndices(*usIndices);
+    else if (auto ubIndices = jointIndices.cast<ubvec4Array>())
+        indices = convertJointIndices(*ubIndices);
+    else if (!jointIndices.cast<ivec4Array>() && !jointIndices.cast<uivec4Array>())
+    {
+        warn("ComputeSkinning::_setUp() unsupported jointIndices type ", jointIndices->className());
+        return;
+    }
+
+    // the packed palettes are updated via the instance views during the record traversal so need transferring after it
+    uint32_t paletteCount = jointCount * instanceCount;
+    if (!jointMatrices || jointMatrices->size() != paletteCount) jointMatrices = mat4Array::create(paletteCount);
+    jointMatrices->properties.dataVariance = DYNAMIC_DATA_TRANSFER_AFTER_RECORD;
+
+    uint32_t paletteSize = jointCount * static_cast<uint32_t>(sizeof(mat4));
+    _instanceJointMatrices.resize(instanceCount);
+    _instanceModifiedCounts.resize(instanceCount);
+    for (uint32_t i = 0; i < instanceCount; ++i)
+    {
+        _instanceJointMatrices[i] = mat4Array::create(jointMatrices, i * paletteSize, static_cast<uint32_t>(sizeof(mat4)), jointCount);
+    }
+
+    // skinned vertices for all the instances followed by the skinned normals
+    VkDeviceSize verticesSize = vertices->dataSize() * instanceCount;
+    VkDeviceSize totalSize = verticesSize;
+    _attributeMask = 0;
+    if (skinNormals)
+    {
+        _attributeMask |= NORMALS_BIT;
+        _skinnedNormalsOffset = ((verticesSize + storageBufferAlignment - 1) / storageBufferAlignment) * storageBufferAlignment;
+        totalSize = _skinnedNormalsOffset + normals->dataSize() * instanceCount;
+    }
+    _skinnedBuffer = Buffer::create(totalSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE);
+
+    auto outputVertices = BufferInfo::create(_skinnedBuffer, 0, verticesSize);
+    auto outputNormals = skinNormals ? BufferInfo::create(_skinnedBuffer, _skinnedNormalsOffset, totalSize - _skinnedNormalsOffset) : outputVertices;
+    auto sourceVertices = BufferInfo::create(vertices);
+    auto sourceNormals = skinNormals ? BufferInfo::create(normals) : sourceVertices;
+
+    // bindings for absent normals alias the vertices, the shader doesn't access them
+    auto storageBuffer = [](uint32_t binding, const ref_ptr<BufferInfo>& bufferInfo) {
+        return DescriptorBuffer::create(BufferInfoList{bufferInfo}, binding, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    };
+
+    Descriptors descriptors{
+        storageBuffer(0, sourceVertices),
+        storageBuffer(1, sourceNormals),
+        storageBuffer(2, BufferInfo::create(indices)),
+        storageBuffer(3, BufferInfo::create(jointWeights)),
+        storageBuffer(4, BufferInfo::create(jointMatrices)),
+        storageBuffer(5, outputVertices),
+        storageBuffer(6, outputNormals)};
+
+    DescriptorSetLayoutBindings bindings;
+    for (uint32_t binding = 0; binding < descriptors.size(); ++binding)
+    {
+        bindings.push_back(VkDescriptorSetLayoutBinding{binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr});
+    }
+
+    auto descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    auto pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{descriptorSetLayout}, PushConstantRanges{{VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(sizeof(PushConstants))}});
+    auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", computeSkinning_comp);
+
+    _bindComputePipeline = BindComputePipeline::create(ComputePipeline::create(pipelineLayout, computeShader));
+    _bindDescriptorSet = BindDescriptorSet::create(VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, DescriptorSet::create(descriptorSetLayout, descriptors));
+}
+
+void ComputeSkinning::compile(Context& context)
+{
+    _setUp();
+
+    if (!_bindComputePipeline) return;
+
+    // allocate the skinned buffer from device local memory before the DescriptorBuffer compile, which would otherwise bind host visible memory to it
+    if (_skinnedBuffer->compile(context.device))
+    {
+        auto memRequirements = _skinnedBuffer->getMemoryRequirements(context.deviceID);
+        auto [deviceMemory, offset] = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (deviceMemory)
+        {
+            _skinnedBuffer->bind(deviceMemory, offset);
+        }
+        else
+        {
+            throw Exception{"Error: ComputeSkinning::compile(..) failed to allocate skinned vertex buffer.", VK_ERROR_OUT_OF_DEVICE_MEMORY};
+        }
+    }
+
+    _bindComputePipeline->compile(context);
+    _bindDescriptorSet->compile(context);
+}
+
+void ComputeSkinning::record(CommandBuffer& commandBuffer) const
+{
+    if (!_bindComputePipeline) return;
+
+    // JointSampler writes the palettes via the instance views, so mark the corresponding ranges of the packed jointMatrices as dirty,
+    // the TransferTask then copies just those ranges after the record traversal and before the dispatch executes.
+    size_t paletteSize = static_cast<size_t>(jointCount) * sizeof(mat4);
+    for (size_t i = 0; i < _instanceJointMatrices.size(); ++i)
+    {
+        if (_instanceJointMatrices[i]->getModifiedCount(_instanceModifiedCounts[i]))
+        {
+            jointMatrices->dirty(i * paletteSize, (i + 1) * paletteSize);
+        }
+    }
+
+    auto deviceID = commandBuffer.deviceID;
+    VkCommandBuffer cmdBuffer{commandBuffer};
+
+    PushConstants pushConstants;
+    pushConstants.vertexCount = static_cast<uint32_t>(vertices->size());
+    pushConstants.jointCount = jointCount;
+    pushConstants.attributeMask = _attributeMask;
+    pushConstants.padding = 0;
+
+    // previous frame's draws must have finished reading the skinned vertices before they are rewritten
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = 0;
+    memoryBarrier.dstAccessMask = 0;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    _bindComputePipeline->record(commandBuffer);
+    _bindDescriptorSet->record(commandBuffer);
+    vkCmdPushConstants(cmdBuffer, _bindComputePipeline->pipeline->layout->vk(deviceID), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
+    vkCmdDispatch(cmdBuffer, (pushConstants.vertexCount + workgroupSize - 1) / workgroupSize, instanceCount, 1);
+
+    memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+}
@@ -138,9 +138,9 @@ void TransformSampler::update(double time)
 {
     if (keyframes)
     {
-        sample(time, keyframes->positions, position);
-        sample(time, keyframes->rotations, rotation);
-        sample(time, keyframes->scales, scale);
+        sample(time, keyframes->positions, position, _positionCursor);
+        sample(time, keyframes->rotations, rotation, _rotationCursor);
+        sample(time, keyframes->scales, scale, _scaleCursor);
     }
 
     if (object) object->accept(*this);
@@ -0,0 +1,259 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/OcclusionBuffer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace vsg;
+
+OcclusionBuffer::OcclusionBuffer(uint32_t in_width, uint32_t in_height) :
+    width(std::max(in_width, tileSize)),
+    height(std::max(in_height, tileSize))
+{
+    _numTilesX = (width + tileSize - 1) / tileSize;
+    _numTilesY = (height + tileSize - 1) / tileSize;
+    _depth.resize(static_cast<size_t>(width) * height);
+    _tileDepth.resize(static_cast<size_t>(_numTilesX) * _numTilesY);
+
+    clear();
+}
+
+OcclusionBuffer::~OcclusionBuffer()
+{
+}
+
+void OcclusionBuffer::clear()
+{
+    // depth values are reset lazily by the first call to rasterize()
+    std::fill(_tileDepth.begin(), _tileDepth.end(), std::numeric_limits<float>::max());
+
+    _dirtyMinX = static_cast<int32_t>(width);
+    _dirtyMinY = static_cast<int32_t>(height);
+    _dirtyMaxX = -1;
+    _dirtyMaxY = -1;
+    _empty = true;
+
+    numOccludersRasterized = 0;
+    numTrianglesRasterized = 0;
+    numTested = 0;
+    numOccluded = 0;
+}
+
+void OcclusionBuffer::rasterize(const dmat4& projection, const dmat4& modelview, const vec3Array& vertices, const Data* indices)
+{
+    // occlusion culling is only supported for perspective projections, as it relies on clip space w being the eye space distance
+    if (projection[3][3] != 0.0) return;
+
+    if (_empty)
+    {
+        std::fill(_depth.begin(), _depth.end(), std::numeric_limits<float>::max());
+        _empty = false;
+    }
+
+    auto mvp = projection * modelview;
+
+    std::vector<dvec4> clipVertices(vertices.size());
+    auto clip_itr = clipVertices.begin();
+    for (const auto& v : vertices)
+    {
+        *(clip_itr++) = mvp * dvec4(v.x, v.y, v.z, 1.0);
+    }
+
+    auto triangle = [&](uint32_t i0, uint32_t i1, uint32_t i2) {
+        if (i0 < clipVertices.size() && i1 < clipVertices.size() && i2 < clipVertices.size())
+        {
+            _rasterizeTriangle(clipVertices[i0], clipVertices[i1], clipVertices[i2]);
+        }
+    };
+
+    if (auto us_indices = indices ? indices->cast<ushortArray>() : nullptr)
+    {
+        for (size_t i = 0; i + 2 < us_indices->size(); i += 3) triangle(us_indices->at(i), us_indices->at(i + 1), us_indices->at(i + 2));
+    }
+    else if (auto ui_indices = indices ? indices->cast<uintArray>() : nullptr)
+    {
+        for (size_t i = 0; i + 2 < ui_indices->size(); i += 3) triangle(ui_indices->at(i), ui_indices->at(i + 1), ui_indices->at(i + 2));
+    }
+    else if (!indices)
+    {
+        for (uint32_t i = 0; i + 2 < static_cast<uint32_t>(clipVertices.size()); i += 3) triangle(i, i + 1, i + 2);
+    }
+
+    ++numOccludersRasterized;
+
+    _updateTiles();
+}
+
+void OcclusionBuffer::_rasterizeTriangle(const dvec4& c0, const dvec4& c1, const dvec4& c2)
+{
+    // skip triangles that cross the near plane, dropping occluder triangles keeps the culling conservative
+    if (c0.w < nearDistance || c1.w < nearDistance || c2.w < nearDistance) return;
+
+    auto toScreen = [&](const dvec4& c) {
+        return dvec3((c.x / c.w * 0.5 + 0.5) * static_cast<double>(width), (c.y / c.w * 0.5 + 0.5) * static_cast<double>(height), 1.0 / c.w);
+    };
+
+    dvec3 s0 = toScreen(c0);
+    dvec3 s1 = toScreen(c1);
+    dvec3 s2 = toScreen(c2);
+
+    double area = (s1.x - s0.x) * (s2.y - s0.y) - (s2.x - s0.x) * (s1.y - s0.y);
+    if (area == 0.0) return;
+
+    // occluders are double sided so make the winding consistent
+    if (area < 0.0)
+    {
+        std::swap(s1, s2);
+        area = -area;
+    }
+
+    int32_t minX = std::max(0, static_cast<int32_t>(std::floor(std::min({s0.x, s1.x, s2.x}))));
+    int32_t minY = std::max(0, static_cast<int32_t>(std::floor(std::min({s0.y, s1.y, s2.y}))));
+    int32_t maxX = std::min(static_cast<int32_t>(width) - 1, static_cast<int32_t>(std::ceil(std::max({s0.x, s1.x, s2.x}))));
+    int32_t maxY = std::min(static_cast<int32_t>(height) - 1, static_cast<int32_t>(std::ceil(std::max({s0.y, s1.y, s2.y}))));
+    if (minX > maxX || minY > maxY) return;
+
+    auto edge = [](const dvec3& a, const dvec3& b, double px, double py) {
+        return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+    };
+
+    double inv_area = 1.0 / area;
+    bool written = false;
+
+    for (int32_t y = minY; y <= maxY; ++y)
+    {
+        double py = static_cast<double>(y) + 0.5;
+        float* row = _depth.data() + static_cast<size_t>(y) * width;
+        for (int32_t x = minX; x <= maxX; ++x)
+        {
+            double px = static_cast<double>(x) + 0.5;
+            double w0 = edge(s1, s2, px, py);
+            double w1 = edge(s2, s0, px, py);
+            double w2 = edge(s0, s1, px, py);
+            if (w0 < 0.0 || w1 < 0.0 || w2 < 0.0) continue;
+
+            // 1/w interpolates linearly in screen space
+            double inv_w = (w0 * s0.z + w1 * s1.z + w2 * s2.z) * inv_area;
+            if (inv_w <= 0.0) continue;
+
+            float distance = static_cast<float>(1.0 / inv_w);
+            if (distance < row[x])
+            {
+                row[x] = distance;
+                written = true;
+            }
+        }
+    }
+
+    if (written)
+    {
+        ++numTrianglesRasterized;
+        _dirtyMinX = std::min(_dirtyMinX, minX);
+        _dirtyMinY = std::min(_dirtyMinY, minY);
+        _dirtyMaxX = std::max(_dirtyMaxX, maxX);
+        _dirtyMaxY = std::max(_dirtyMaxY, maxY);
+    }
+}
+
+void OcclusionBuffer::_updateTiles()
+{
+    if (_dirtyMaxX < _dirtyMinX || _dirtyMaxY < _dirtyMinY) return;
+
+    uint32_t tileMinX = static_cast<uint32_t>(_dirtyMinX) / tileSize;
+    uint32_t tileMinY = static_cast<uint32_t>(_dirtyMinY) / tileSize;
+    uint32_t tileMaxX = static_cast<uint32_t>(_dirtyMaxX) / tileSize;
+    uint32_t tileMaxY = static_cast<uint32_t>(_dirtyMaxY) / tileSize;
+
+    for (uint32_t ty = tileMinY; ty <= tileMaxY; ++ty)
+    {
+        for (uint32_t tx = tileMinX; tx <= tileMaxX; ++tx)
+        {
+            float maxDistance = 0.0f;
+            uint32_t endY = std::min((ty + 1) * tileSize, height);
+            uint32_t endX = std::min((tx + 1) * tileSize, width);
+            for (uint32_t y = ty * tileSize; y < endY; ++y)
+            {
+                const float* row = _depth.data() + static_cast<size_t>(y) * width;
+                for (uint32_t x = tx * tileSize; x < endX; ++x)
+                {
+                    maxDistance = std::max(maxDistance, row[x]);
+                }
+            }
+            _tileDepth[static_cast<size_t>(ty) * _numTilesX + tx] = maxDistance;
+        }
+    }
+
+    _dirtyMinX = static_cast<int32_t>(width);
+    _dirtyMinY = static_cast<int32_t>(height);
+    _dirtyMaxX = -1;
+    _dirtyMaxY = -1;
+}
+
+bool OcclusionBuffer::occluded(const dmat4& projection, const dmat4& modelview, const dsphere& sphere)
+{
+    if (_empty || projection[3][3] != 0.0) return false;
+
+    ++numTested;
+
+    // transform the sphere into eye space, scaling the radius by the largest axis scale of the modelview matrix
+    dvec3 center = modelview * sphere.center;
+    double scale = std::sqrt(std::max({modelview[0][0] * modelview[0][0] + modelview[0][1] * modelview[0][1] + modelview[0][2] * modelview[0][2],
+                                       modelview[1][0] * modelview[1][0] + modelview[1][1] * modelview[1][1] + modelview[1][2] * modelview[1][2],
+                                       modelview[2][0] * modelview[2][0] + modelview[2][1] * modelview[2][1] + modelview[2][2] * modelview[2][2]}));
+    double radius = sphere.radius * scale;
+
+    // nearest eye space distance of the sphere, the eye looks down the -z axis
+    double nearest = -center.z - radius;
+    if (nearest < nearDistance) return false;
+
+    // project the corners of the sphere's eye space bounding box to get a conservative screen space rectangle
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (int i = 0; i < 8; ++i)
+    {
+        dvec4 corner((i & 1) ? center.x + radius : center.x - radius,
+                     (i & 2) ? center.y + radius : center.y - radius,
+                     (i & 4) ? center.z + radius : center.z - radius,
+                     1.0);
+        dvec4 clip = projection * corner;
+        double sx = (clip.x / clip.w * 0.5 + 0.5) * static_cast<double>(width);
+        double sy = (clip.y / clip.w * 0.5 + 0.5) * static_cast<double>(height);
+        minX = std::min(minX, sx);
+        minY = std::min(minY, sy);
+        maxX = std::max(maxX, sx);
+        maxY = std::max(maxY, sy);
+    }
+
+    // bounds that extend outside the buffer may be visible in regions with no occluder information
+    if (minX < 0.0 || minY < 0.0 || maxX >= static_cast<double>(width) || maxY >= static_cast<double>(height)) return false;
+
+    uint32_t tileMinX = static_cast<uint32_t>(minX) / tileSize;
+    uint32_t tileMinY = static_cast<uint32_t>(minY) / tileSize;
+    uint32_t tileMaxX = static_cast<uint32_t>(maxX) / tileSize;
+    uint32_t tileMaxY = static_cast<uint32_t>(maxY) / tileSize;
+
+    for (uint32_t ty = tileMinY; ty <= tileMaxY; ++ty)
+    {
+        for (uint32_t tx = tileMinX; tx <= tileMaxX; ++tx)
+        {
+            if (static_cast<double>(_tileDepth[static_cast<size_t>(ty) * _numTilesX + tx]) >= nearest) return false;
+        }
+    }
+
+    ++numOccluded;
+    return true;
+}
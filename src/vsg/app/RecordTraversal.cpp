@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/animation/Animation.h>
 #include <vsg/app/CommandGraph.h>
+#include <vsg/app/OcclusionBuffer.h>
 #include <vsg/app/RecordTraversal.h>
 #include <vsg/app/View.h>
 #include <vsg/commands/Command.h>
@@ -25,6 +26,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/lighting/PointLight.h>
 #include <vsg/lighting/SpotLight.h>
 #include <vsg/maths/plane.h>
+#include <vsg/nodes/BatchCullGroup.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/nodes/CoordinateFrame.h>
 #include <vsg/nodes/CullGroup.h>
@@ -38,6 +40,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/LOD.h>
 #include <vsg/nodes/Layer.h>
 #include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/Occluder.h>
 #include <vsg/nodes/PagedLOD.h>
 #include <vsg/nodes/QuadGroup.h>
 #include <vsg/nodes/RegionOfInterest.h>
@@ -163,6 +166,12 @@ void RecordTraversal::apply(const LOD& lod)
         return;
     }
 
+    // check if lod bounding sphere is hidden behind occluders.
+    if (occlusionBuffer && occlusionBuffer->occluded(state->projectionMatrixStack.top(), state->modelviewMatrixStack.top(), sphere))
+    {
+        return;
+    }
+
     if (viewDependentState) lodDistance *= viewDependentState->LODScale;
 
     for (auto& child : lod.children)
@@ -221,7 +230,7 @@ void RecordTraversal::apply(const PagedLOD& plod)
             else if (databasePager)
             {
                 auto priority = sphere.r / cutoff;
-                exchange_if_greater(plod.priority, priority);
+                bool priorityIncreased = exchange_if_greater(plod.priority, priority);
 
                 auto previousRequestCount = plod.requestCount.fetch_add(1);
                 if (previousRequestCount == 0)
@@ -229,6 +238,11 @@ void RecordTraversal::apply(const PagedLOD& plod)
                     // we are the first request so tell the databasePager about it
                     databasePager->request(ref_ptr<PagedLOD>(const_cast<PagedLOD*>(&plod)));
                 }
+                else if (priorityIncreased)
+                {
+                    // already queued so let the databasePager reorder its queue
+                    databasePager->updatePriority(&plod);
+                }
                 else
                 {
                     //debug("repeat request ",&plod,", ",plod.filename,", ",plod.requestCount.load(),", plod.requestStatus = ",plod.requestStatus.load());
@@ -272,6 +286,8 @@ void RecordTraversal::apply(const CullGroup& cullGroup)
 
     if (state->intersect(cullGroup.bound))
     {
+        if (occlusionBuffer && occlusionBuffer->occluded(state->projectionMatrixStack.top(), state->modelviewMatrixStack.top(), cullGroup.bound)) return;
+
         // debug("Passed node");
         cullGroup.traverse(*this);
     }
@@ -283,11 +299,50 @@ void RecordTraversal::apply(const CullNode& cullNode)
 
     if (state->intersect(cullNode.bound))
     {
+        if (occlusionBuffer && occlusionBuffer->occluded(state->projectionMatrixStack.top(), state->modelviewMatrixStack.top(), cullNode.bound)) return;
+
         //debug("Passed node");
         cullNode.traverse(*this);
     }
 }
 
+void RecordTraversal::apply(const BatchCullGroup& batchCullGroup)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "BatchCullGroup", COLOR_RECORD_L2, &batchCullGroup);
+
+    // an invalid bound indicates children without bounds that must always be traversed
+    if (batchCullGroup.bound.valid())
+    {
+        if (!state->intersect(batchCullGroup.bound)) return;
+
+        if (occlusionBuffer && occlusionBuffer->occluded(state->projectionMatrixStack.top(), state->modelviewMatrixStack.top(), batchCullGroup.bound)) return;
+    }
+
+    // test the child bounds against the frustum in batches of 64, traversing the children that pass
+    const auto& frustum = state->_frustumStack.top();
+    const auto& children = batchCullGroup.children;
+    for (size_t firstChild = 0; firstChild < children.size(); firstChild += 64)
+    {
+        auto mask = batchCullGroup.intersect(frustum.face, POLYTOPE_SIZE, firstChild);
+        for (size_t i = firstChild; mask != 0; ++i, mask >>= 1)
+        {
+            if ((mask & 1) != 0) children[i].node->accept(*this);
+        }
+    }
+}
+
+void RecordTraversal::apply(const Occluder& occluder)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "Occluder", COLOR_RECORD_L2, &occluder);
+
+    if (occlusionBuffer && occluder.vertices)
+    {
+        occlusionBuffer->rasterize(state->projectionMatrixStack.top(), state->modelviewMatrixStack.top(), *occluder.vertices, occluder.indices.get());
+    }
+
+    occluder.traverse(*this);
+}
+
 void RecordTraversal::apply(const Switch& sw)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "Switch", COLOR_RECORD_L2, &sw);
@@ -576,6 +631,7 @@ void RecordTraversal::apply(const View& view)
     cached_bins.swap(bins);
 
     auto cached_viewDependentState = viewDependentState;
+    auto cached_occlusionBuffer = occlusionBuffer;
 
     decltype(regionsOfInterest) cached_regionsOfInterest;
     cached_regionsOfInterest.swap(regionsOfInterest);
@@ -605,6 +661,23 @@ void RecordTraversal::apply(const View& view)
         viewDependentState->LODScale = view.LODScale;
     }
 
+    // assign and clear this traversal's OcclusionBuffer for the View, matching the settings of the View's OcclusionBuffer
+    if (view.occlusionBuffer)
+    {
+        auto& viewOcclusionBuffer = _occlusionBuffers[&view];
+        if (!viewOcclusionBuffer || viewOcclusionBuffer->width != view.occlusionBuffer->width || viewOcclusionBuffer->height != view.occlusionBuffer->height)
+        {
+            viewOcclusionBuffer = OcclusionBuffer::create(view.occlusionBuffer->width, view.occlusionBuffer->height);
+        }
+        viewOcclusionBuffer->nearDistance = view.occlusionBuffer->nearDistance;
+        viewOcclusionBuffer->clear();
+        occlusionBuffer = viewOcclusionBuffer;
+    }
+    else
+    {
+        occlusionBuffer = {};
+    }
+
     state->pushView(view);
 
     if (view.camera)
@@ -666,6 +739,13 @@ void RecordTraversal::apply(const View& view)
     cached_regionsOfInterest.swap(regionsOfInterest);
     state->_commandBuffer->traversalMask = cached_traversalMask;
     viewDependentState = cached_viewDependentState;
+    occlusionBuffer = cached_occlusionBuffer;
+}
+
+OcclusionBuffer* RecordTraversal::getOcclusionBuffer(const View& view) const
+{
+    if (auto itr = _occlusionBuffers.find(&view); itr != _occlusionBuffers.end()) return itr->second.get();
+    return nullptr;
 }
 
 void RecordTraversal::apply(const CommandGraph& commandGraph)
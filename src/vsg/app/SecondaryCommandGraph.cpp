@@ -16,9 +16,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/commands/ExecuteCommands.h>
 #include <vsg/io/DatabasePager.h>
 #include <vsg/lighting/Light.h>
+#include <vsg/nodes/QuadGroup.h>
+#include <vsg/nodes/StateGroup.h>
 #include <vsg/ui/ApplicationEvent.h>
 #include <vsg/vk/State.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 SecondaryCommandGraph::SecondaryCommandGraph(ref_ptr<Device> in_device, int family) :
@@ -174,3 +178,117 @@ ref_ptr<SecondaryCommandGraph> vsg::createSecondaryCommandGraphForView(ref_ptr<W
 
     return commandGraph;
 }
+
+namespace
+{
+    struct CountNodes : public ConstVisitor
+    {
+        size_t count = 0;
+
+        void apply(const Node& node) override
+        {
+            ++count;
+            node.traverse(*this);
+        }
+    };
+} // namespace
+
+CommandGraphs vsg::createParallelCommandGraphsForView(ref_ptr<Window> window, ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, uint32_t numPartitions, bool assignHeadlight)
+{
+    // collect the top level children that can be distributed between the partitions
+    auto stateGroup = scenegraph.cast<StateGroup>();
+    std::vector<ref_ptr<Node>> children;
+    if (stateGroup || (scenegraph && scenegraph->type_info() == typeid(Group)))
+    {
+        for (auto& child : scenegraph.cast<Group>()->children)
+        {
+            if (child) children.push_back(child);
+        }
+    }
+    else if (auto quadGroup = scenegraph.cast<QuadGroup>())
+    {
+        for (auto& child : quadGroup->children)
+        {
+            if (child) children.push_back(child);
+        }
+    }
+
+    // set up a root node for each partition
+    std::vector<ref_ptr<Group>> partitionRoots;
+    if (children.empty())
+    {
+        auto root = Group::create();
+        if (scenegraph) root->addChild(scenegraph);
+        partitionRoots.push_back(root);
+    }
+    else
+    {
+        size_t numRoots = std::max(size_t(1), std::min(static_cast<size_t>(numPartitions), children.size()));
+        for (size_t i = 0; i < numRoots; ++i)
+        {
+            if (stateGroup)
+            {
+                // share the StateGroup's state between all partitions
+                auto partitionStateGroup = StateGroup::create();
+                partitionStateGroup->stateCommands = stateGroup->stateCommands;
+                partitionStateGroup->prototypeArrayState = stateGroup->prototypeArrayState;
+                partitionRoots.push_back(partitionStateGroup);
+            }
+            else
+            {
+                partitionRoots.push_back(Group::create());
+            }
+        }
+    }
+
+    // greedily assign the largest remaining subgraph to the partition with the smallest total, lights are assigned to all partitions
+    std::vector<std::pair<size_t, ref_ptr<Node>>> weightedChildren;
+    for (auto& child : children)
+    {
+        if (!child) continue;
+
+        if (child->is_compatible(typeid(Light)))
+        {
+            for (auto& root : partitionRoots) root->addChild(child);
+            continue;
+        }
+
+        CountNodes countNodes;
+        child->accept(countNodes);
+        weightedChildren.emplace_back(countNodes.count, child);
+    }
+
+    std::stable_sort(weightedChildren.begin(), weightedChildren.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    std::vector<size_t> partitionWeights(partitionRoots.size(), 0);
+    for (auto& [weight, child] : weightedChildren)
+    {
+        auto smallest = std::min_element(partitionWeights.begin(), partitionWeights.end()) - partitionWeights.begin();
+        partitionRoots[smallest]->addChild(child);
+        partitionWeights[smallest] += weight;
+    }
+
+    // set up the primary CommandGraph that executes the secondary CommandBuffer recorded for each partition
+    auto executeCommands = ExecuteCommands::create();
+
+    auto renderGraph = RenderGraph::create(window);
+    renderGraph->contents = VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
+    if (camera && camera->viewportState)
+    {
+        renderGraph->renderArea = camera->getRenderArea();
+        renderGraph->viewportState->set(renderGraph->renderArea.offset.x, renderGraph->renderArea.offset.y, renderGraph->renderArea.extent.width, renderGraph->renderArea.extent.height);
+    }
+    renderGraph->addChild(executeCommands);
+
+    CommandGraphs commandGraphs;
+    commandGraphs.push_back(CommandGraph::create(window, renderGraph));
+
+    for (auto& root : partitionRoots)
+    {
+        auto secondaryCommandGraph = createSecondaryCommandGraphForView(window, camera, root, 0, assignHeadlight);
+        executeCommands->connect(secondaryCommandGraph);
+        commandGraphs.push_back(secondaryCommandGraph);
+    }
+
+    return commandGraphs;
+}
@@ -18,6 +18,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/utils/Instrumentation.h>
 #include <vsg/vk/State.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 TransferTask::TransferTask(Device* in_device, uint32_t numBuffers) :
@@ -109,13 +111,16 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
     auto deviceID = device->deviceID;
     auto& staging = frame.staging;
     auto& copyRegions = frame.copyRegions;
+    auto& dirtyRanges = frame.dirtyRanges;
     auto& buffer_data = frame.buffer_data;
 
     VkDeviceSize alignment = 4;
+    auto alignedSize = [&alignment](VkDeviceSize size) { return (/*alignment == 1 ||*/ (size % alignment) == 0) ? size : ((size / alignment) + 1) * alignment; };
 
     copyRegions.clear();
-    copyRegions.resize(dataToCopy.dataTotalRegions);
-    VkBufferCopy* pRegions = copyRegions.data();
+    copyRegions.reserve(dataToCopy.dataTotalRegions);
+
+    VkDeviceSize startOffset = offset;
 
     log(level, "  TransferTask::_transferBufferInfos(..) ", this);
 
@@ -124,7 +129,7 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
     {
         auto& bufferInfos = buffer_itr->second;
 
-        uint32_t regionCount = 0;
+        size_t firstRegion = copyRegions.size();
         log(level, "    copying bufferInfos.size() = ", bufferInfos.size(), "{");
         for (auto bufferInfo_itr = bufferInfos.begin(); bufferInfo_itr != bufferInfos.end();)
         {
@@ -136,19 +141,59 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
             }
             else
             {
+                auto previousModifiedCount = bufferInfo->copiedModifiedCounts[deviceID];
                 if (bufferInfo->syncModifiedCounts(deviceID))
                 {
-                    // copy data to staging buffer memory
-                    char* ptr = reinterpret_cast<char*>(buffer_data) + offset;
-                    std::memcpy(ptr, bufferInfo->data->dataPointer(), bufferInfo->range);
-
-                    // record region
-                    pRegions[regionCount++] = VkBufferCopy{offset, bufferInfo->offset, bufferInfo->range};
-
-                    log(level, "       copying ", bufferInfo, ", ", bufferInfo->data, " to ", static_cast<void*>(ptr));
-
-                    VkDeviceSize endOfEntry = offset + bufferInfo->range;
-                    offset = (/*alignment == 1 ||*/ (endOfEntry % alignment) == 0) ? endOfEntry : ((endOfEntry / alignment) + 1) * alignment;
+                    auto& data = bufferInfo->data;
+                    const char* data_ptr = static_cast<const char*>(data->dataPointer());
+
+                    // when only parts of the data have been modified just copy those ranges, provided they fit within the staging space reserved for the whole range
+                    dirtyRanges.clear();
+                    bool copyDirtyRanges = data->getDirtyRanges(previousModifiedCount, dirtyRanges);
+                    if (copyDirtyRanges)
+                    {
+                        VkDeviceSize dirtySize = 0;
+                        for (auto& range : dirtyRanges)
+                        {
+                            range.end = std::min(range.end, static_cast<size_t>(bufferInfo->range));
+                            if (range.begin < range.end) dirtySize += alignedSize(range.end - range.begin);
+                        }
+                        copyDirtyRanges = dirtySize <= alignedSize(bufferInfo->range);
+                    }
+
+                    if (copyDirtyRanges)
+                    {
+                        for (const auto& range : dirtyRanges)
+                        {
+                            if (range.begin >= range.end) continue;
+
+                            VkDeviceSize size = range.end - range.begin;
+                            char* ptr = reinterpret_cast<char*>(buffer_data) + offset;
+                            std::memcpy(ptr, data_ptr + range.begin, size);
+
+                            copyRegions.push_back(VkBufferCopy{offset, bufferInfo->offset + range.begin, size});
+
+                            offset = alignedSize(offset + size);
+                        }
+
+                        log(level, "       copying ", dirtyRanges.size(), " dirty ranges of ", bufferInfo, ", ", data);
+                    }
+                    else
+                    {
+                        // copy data to staging buffer memory
+                        char* ptr = reinterpret_cast<char*>(buffer_data) + offset;
+                        std::memcpy(ptr, data_ptr, bufferInfo->range);
+
+                        // record region
+                        copyRegions.push_back(VkBufferCopy{offset, bufferInfo->offset, bufferInfo->range});
+
+                        log(level, "       copying ", bufferInfo, ", ", data, " to ", static_cast<void*>(ptr));
+
+                        offset = alignedSize(offset + bufferInfo->range);
+                    }
+
+                    // the dirty ranges up to this modification have now been copied
+                    data->pruneDirtyRanges(bufferInfo->copiedModifiedCounts[deviceID]);
                 }
                 else
                 {
@@ -168,16 +213,14 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
         }
         log(level, "    } bufferInfos.size() = ", bufferInfos.size(), "{");
 
-        if (regionCount > 0)
+        if (auto regionCount = static_cast<uint32_t>(copyRegions.size() - firstRegion); regionCount > 0)
         {
             auto& buffer = buffer_itr->first;
+            VkBufferCopy* pRegions = copyRegions.data() + firstRegion;
 
             vkCmdCopyBuffer(vk_commandBuffer, staging->vk(deviceID), buffer->vk(deviceID), regionCount, pRegions);
 
             log(level, "   vkCmdCopyBuffer(", ", ", staging->vk(deviceID), ", ", buffer->vk(deviceID), ", ", regionCount, ", ", pRegions);
-
-            // advance to next buffer
-            pRegions += regionCount;
         }
 
         if (bufferInfos.empty())
@@ -190,6 +233,8 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
             ++buffer_itr;
         }
     }
+
+    log(level, "  TransferTask::_transferBufferInfos(..) copied ", offset - startOffset, " bytes in ", copyRegions.size(), " regions");
 }
 
 void TransferTask::assign(const ImageInfoList& imageInfoList)
@@ -614,6 +614,14 @@ void ConstVisitor::apply(const CullNode& value)
 {
     apply(static_cast<const Node&>(value));
 }
+void ConstVisitor::apply(const BatchCullGroup& value)
+{
+    apply(static_cast<const Node&>(value));
+}
+void ConstVisitor::apply(const Occluder& value)
+{
+    apply(static_cast<const Group&>(value));
+}
 void ConstVisitor::apply(const Transform& value)
 {
     apply(static_cast<const Group&>(value));
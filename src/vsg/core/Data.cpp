@@ -18,6 +18,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 #include <vsg/io/Output.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 int Data::Properties::compare(const Properties& rhs) const
@@ -133,6 +135,69 @@ void Data::_clear()
     if (getAuxiliary()) getAuxiliary()->clear();
 }
 
+void Data::dirty(size_t begin, size_t end)
+{
+    if (!_dirtyRangesTracked)
+    {
+        // consumers in sync with the current modification can use the dirty ranges from here on
+        _dirtyRangesTracked = true;
+        _dirtyRangesStart = _modifiedCount;
+    }
+
+    ++_modifiedCount;
+
+    if (begin >= end) return;
+
+    // find the first range that overlaps or is adjacent to [begin, end)
+    auto itr = std::lower_bound(_dirtyRanges.begin(), _dirtyRanges.end(), begin, [](const DirtyRange& range, size_t value) { return range.end < value; });
+
+    // merge all the ranges that overlap or are adjacent to [begin, end)
+    auto last = itr;
+    for (; last != _dirtyRanges.end() && last->begin <= end; ++last)
+    {
+        begin = std::min(begin, last->begin);
+        end = std::max(end, last->end);
+    }
+
+    if (itr != last)
+    {
+        *itr = DirtyRange{begin, end, _modifiedCount};
+        _dirtyRanges.erase(itr + 1, last);
+    }
+    else
+    {
+        _dirtyRanges.insert(itr, DirtyRange{begin, end, _modifiedCount});
+    }
+
+    // too many distinct ranges to be worth tracking so fall back to treating all the data as modified
+    if (_dirtyRanges.size() > maxDirtyRanges) _clearDirtyRanges();
+}
+
+bool Data::getDirtyRanges(const ModifiedCount& mc, std::vector<DirtyRange>& ranges) const
+{
+    if (!_dirtyRangesTracked || mc.count < _dirtyRangesStart.count) return false;
+
+    for (const auto& range : _dirtyRanges)
+    {
+        if (range.modifiedCount.count > mc.count) ranges.push_back(range);
+    }
+    return true;
+}
+
+void Data::pruneDirtyRanges(const ModifiedCount& mc)
+{
+    if (!_dirtyRangesTracked || mc.count < _dirtyRangesStart.count) return;
+
+    _dirtyRanges.erase(std::remove_if(_dirtyRanges.begin(), _dirtyRanges.end(), [&mc](const DirtyRange& range) { return range.modifiedCount.count <= mc.count; }), _dirtyRanges.end());
+    _dirtyRangesStart = mc;
+}
+
+void Data::_clearDirtyRanges()
+{
+    _dirtyRangesTracked = false;
+    _dirtyRanges.clear();
+}
+
 void Data::setMipmapLayout(MipmapLayout* mipmapLayout)
 {
     if (mipmapLayout)
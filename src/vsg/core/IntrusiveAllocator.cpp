@@ -16,9 +16,14 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <iostream>
 
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
 using namespace vsg;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -188,8 +193,8 @@ void* IntrusiveAllocator::MemoryBlock::allocate(std::size_t size)
 
                     if (nextPosition < capacity)
                     {
-                        auto& nextSlot = memory[nextPosition];
-                        nextSlot.previous = newSlot.next;
+                        // next slot may be allocated and have its header read by a ThreadCache without the Allocator::mutex
+                        memory[nextPosition].atomicSetPrevious(newSlot.next);
                     }
 
                     if (freePosition == freeList.head)
@@ -358,7 +363,7 @@ bool IntrusiveAllocator::MemoryBlock::deallocate(void* ptr, std::size_t /*size*/
 #endif
             // update slots for the merge
             memory[P].next += memory[C].next + memory[N].next;
-            if (NN != 0) memory[NN].previous = memory[P].next;
+            if (NN != 0) memory[NN].atomicSetPrevious(memory[P].next);
 
             // update freeList linked list entries
             if (PNF == N) // also implies NPF == P
@@ -429,7 +434,7 @@ bool IntrusiveAllocator::MemoryBlock::deallocate(void* ptr, std::size_t /*size*/
         auto mergePC = [&]() -> void {
             // update slots for the merge
             memory[P].next += memory[C].next;
-            if (N != 0) memory[N].previous = memory[P].next;
+            if (N != 0) memory[N].atomicSetPrevious(memory[P].next);
 
                 // freeList linked list entries will not need updating.
 
@@ -446,7 +451,7 @@ bool IntrusiveAllocator::MemoryBlock::deallocate(void* ptr, std::size_t /*size*/
             // update slots for merge
             memory[C].status = 1;
             memory[C].next += memory[N].next;
-            if (NN != 0) memory[NN].previous = memory[C].next;
+            if (NN != 0) memory[NN].atomicSetPrevious(memory[C].next);
 
             // update freeList linked list entries
             if (NPF != 0) memory[NPF + 2].index = C;
@@ -717,9 +722,10 @@ size_t IntrusiveAllocator::MemoryBlock::totalMemorySize() const
 //
 // MemoryBlocks
 //
-IntrusiveAllocator::MemoryBlocks::MemoryBlocks(IntrusiveAllocator* in_parent, const std::string& in_name, size_t in_blockSize, size_t in_alignment) :
+IntrusiveAllocator::MemoryBlocks::MemoryBlocks(IntrusiveAllocator* in_parent, const std::string& in_name, uint32_t in_affinity, size_t in_blockSize, size_t in_alignment) :
     parent(in_parent),
     name(in_name),
+    affinity(in_affinity),
     alignment(in_alignment),
     blockSize(in_blockSize),
     maximumAllocationSize(IntrusiveAllocator::MemoryBlock::computeMaxiumAllocationSize(in_blockSize, in_alignment))
@@ -753,9 +759,11 @@ void* IntrusiveAllocator::MemoryBlocks::allocate(std::size_t size)
     }
 
     auto new_block = std::make_shared<MemoryBlock>(name, new_blockSize, alignment);
+    new_block->affinity = affinity;
     if (parent)
     {
         parent->memoryBlocks[new_block->memory] = new_block;
+        parent->memoryBlockIndex.insert(new_block.get());
     }
 
     if (memoryBlocks.empty())
@@ -799,6 +807,7 @@ size_t IntrusiveAllocator::MemoryBlocks::deleteEmptyMemoryBlocks()
         if (memoryBlock->totalReservedSize() == 0)
         {
             count += memoryBlock->totalAvailableSize();
+            if (parent) parent->memoryBlockIndex.remove(memoryBlock.get());
         }
         else
         {
@@ -840,6 +849,295 @@ size_t IntrusiveAllocator::MemoryBlocks::totalMemorySize() const
     return count;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// MemoryBlockIndex
+//
+IntrusiveAllocator::MemoryBlockIndex::MemoryBlockIndex()
+{
+    for (auto& leaf : root) leaf.store(nullptr, std::memory_order_relaxed);
+}
+
+IntrusiveAllocator::MemoryBlockIndex::~MemoryBlockIndex()
+{
+    for (auto& leaf : root) delete leaf.load(std::memory_order_relaxed);
+}
+
+IntrusiveAllocator::MemoryBlockIndex::Granule* IntrusiveAllocator::MemoryBlockIndex::granule(size_t key, bool create)
+{
+    size_t rootIndex = key >> leafBits;
+    if (rootIndex >= root.size()) return nullptr;
+
+    auto& rootEntry = root[rootIndex];
+    auto leaf = rootEntry.load(std::memory_order_relaxed);
+    if (!leaf)
+    {
+        if (!create) return nullptr;
+
+        leaf = new Leaf;
+        for (auto& entry : leaf->granules)
+        {
+            entry.lower.store(nullptr, std::memory_order_relaxed);
+            entry.lowerEnd.store(0, std::memory_order_relaxed);
+            entry.upper.store(nullptr, std::memory_order_relaxed);
+            entry.upperStart.store(0, std::memory_order_relaxed);
+        }
+        rootEntry.store(leaf, std::memory_order_release);
+    }
+    return &(leaf->granules[key & ((size_t(1) << leafBits) - 1)]);
+}
+
+IntrusiveAllocator::MemoryBlock* IntrusiveAllocator::MemoryBlockIndex::find(const void* ptr) const
+{
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    size_t key = static_cast<size_t>(address >> granularityShift);
+    size_t rootIndex = key >> leafBits;
+    if (rootIndex >= root.size()) return nullptr;
+
+    auto leaf = root[rootIndex].load(std::memory_order_acquire);
+    if (!leaf) return nullptr;
+
+    // the bounds are written after, and cleared before, the block pointers, so a matching bound guarantees the block pointer is current or null.
+    auto& entry = leaf->granules[key & ((size_t(1) << leafBits) - 1)];
+    auto upperStart = entry.upperStart.load(std::memory_order_acquire);
+    if (upperStart != 0 && address >= upperStart) return entry.upper.load(std::memory_order_acquire);
+    if (address < entry.lowerEnd.load(std::memory_order_acquire)) return entry.lower.load(std::memory_order_acquire);
+    return nullptr;
+}
+
+bool IntrusiveAllocator::MemoryBlockIndex::insert(MemoryBlock* block)
+{
+    auto start = reinterpret_cast<uintptr_t>(block->memory);
+    auto end = reinterpret_cast<uintptr_t>(block->memoryEnd);
+
+    // smaller blocks could share a granule with more than one other block
+    if ((end - start) < granularity) return false;
+
+    size_t firstKey = static_cast<size_t>(start >> granularityShift);
+    size_t lastKey = static_cast<size_t>((end - 1) >> granularityShift);
+    if ((lastKey >> leafBits) >= root.size()) return false;
+
+    for (size_t key = firstKey; key <= lastKey; ++key)
+    {
+        auto entry = granule(key, true);
+        if (key == firstKey && (start % granularity) != 0)
+        {
+            entry->upper.store(block, std::memory_order_release);
+            entry->upperStart.store(start, std::memory_order_release);
+        }
+        else
+        {
+            entry->lower.store(block, std::memory_order_release);
+            entry->lowerEnd.store(end, std::memory_order_release);
+        }
+    }
+    return true;
+}
+
+void IntrusiveAllocator::MemoryBlockIndex::remove(MemoryBlock* block)
+{
+    size_t firstKey = static_cast<size_t>(reinterpret_cast<uintptr_t>(block->memory) >> granularityShift);
+    size_t endKey = static_cast<size_t>((reinterpret_cast<uintptr_t>(block->memoryEnd) + granularity - 1) >> granularityShift);
+
+    for (size_t key = firstKey; key < endKey; ++key)
+    {
+        auto entry = granule(key, false);
+        if (!entry) continue;
+
+        if (entry->upper.load(std::memory_order_relaxed) == block)
+        {
+            entry->upperStart.store(0, std::memory_order_release);
+            entry->upper.store(nullptr, std::memory_order_release);
+        }
+        if (entry->lower.load(std::memory_order_relaxed) == block)
+        {
+            entry->lowerEnd.store(0, std::memory_order_release);
+            entry->lower.store(nullptr, std::memory_order_release);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// MemoryBlock::Element atomic access
+//
+IntrusiveAllocator::MemoryBlock::Element IntrusiveAllocator::MemoryBlock::Element::atomicLoad() const
+{
+    Element element;
+#if defined(__cpp_lib_atomic_ref)
+    element.index = std::atomic_ref<const Index>(index).load(std::memory_order_relaxed);
+#elif defined(_MSC_VER)
+    element.index = static_cast<Index>(__iso_volatile_load32(reinterpret_cast<const volatile int*>(&index)));
+#else
+    element.index = __atomic_load_n(&index, __ATOMIC_RELAXED);
+#endif
+    return element;
+}
+
+void IntrusiveAllocator::MemoryBlock::Element::atomicSetPrevious(Offset in_previous)
+{
+    // all writes are made with Allocator::mutex held so only the store of the updated word needs to be atomic
+    Element updated = *this;
+    updated.previous = in_previous;
+#if defined(__cpp_lib_atomic_ref)
+    std::atomic_ref<Index>(index).store(updated.index, std::memory_order_relaxed);
+#elif defined(_MSC_VER)
+    __iso_volatile_store32(reinterpret_cast<volatile int*>(&index), static_cast<int>(updated.index));
+#else
+    __atomic_store_n(&index, updated.index, __ATOMIC_RELAXED);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ThreadCache
+//
+struct IntrusiveAllocator::ThreadCache
+{
+    // slots up to maximumCachedSize are binned into size classes that are multiples of sizeClassGranularity
+    static constexpr size_t sizeClassGranularity = 16;
+    static constexpr size_t numSizeClasses = 16;
+    static constexpr size_t maximumCachedSize = sizeClassGranularity * numSizeClasses;
+
+    using Magazine = std::vector<void*>;
+    using Magazines = std::array<Magazine, numSizeClasses>;
+
+    explicit ThreadCache(IntrusiveAllocator* in_allocator) :
+        allocator(in_allocator) {}
+
+    ~ThreadCache()
+    {
+        if (!allocator) return;
+
+        std::scoped_lock<std::mutex> lock(allocator->mutex);
+        clear();
+
+        auto& caches = allocator->threadCaches;
+        caches.erase(std::remove(caches.begin(), caches.end(), this), caches.end());
+    }
+
+    IntrusiveAllocator* allocator = nullptr;
+    std::vector<Magazines> affinityMagazines;
+
+    static size_t sizeClass(size_t size)
+    {
+        return (std::max(size, size_t(1)) + sizeClassGranularity - 1) / sizeClassGranularity - 1;
+    }
+
+    Magazine& magazine(uint32_t affinity, size_t sizeClassIndex)
+    {
+        if (affinity >= affinityMagazines.size()) affinityMagazines.resize(affinity + 1);
+        return affinityMagazines[affinity][sizeClassIndex];
+    }
+
+    /// take a slot from the cache without locking, return nullptr if none are available
+    void* allocate(size_t size, AllocatorAffinity allocatorAffinity)
+    {
+        if (allocatorAffinity >= affinityMagazines.size()) return nullptr;
+
+        auto& slots = affinityMagazines[allocatorAffinity][sizeClass(size)];
+        if (slots.empty()) return nullptr;
+
+        void* ptr = slots.back();
+        slots.pop_back();
+        return ptr;
+    }
+
+    /// allocate a slot for the caller along with a batch of slots for the cache, must be called with the Allocator::mutex held.
+    void* refill(MemoryBlocks& blocks, size_t size, AllocatorAffinity allocatorAffinity)
+    {
+        size_t sizeClassIndex = sizeClass(size);
+        size_t sizeClassSize = (sizeClassIndex + 1) * sizeClassGranularity;
+
+        void* ptr = blocks.allocate(sizeClassSize);
+        if (!ptr) return nullptr;
+
+        auto& slots = magazine(allocatorAffinity, sizeClassIndex);
+        size_t targetSize = allocator->threadCacheSize / 2;
+        while (slots.size() < targetSize)
+        {
+            void* slot = blocks.allocate(sizeClassSize);
+            if (!slot) break;
+
+            // MemoryBlocks::allocate() leaves memoryBlockWithSpace pointing to the block that the slot came from.
+            auto block = blocks.memoryBlockWithSpace.get();
+            if (allocator->memoryBlockIndex.find(slot) != block)
+            {
+                // only slots from indexed blocks can be cached as the index is used to return them to their block
+                block->deallocate(slot, sizeClassSize);
+                break;
+            }
+
+            slots.push_back(slot);
+        }
+
+        return ptr;
+    }
+
+    /// cache a slot from an indexed MemoryBlock without locking, returning batches to the MemoryBlocks when the cache is full.
+    bool deallocate(void* ptr, const MemoryBlock* block)
+    {
+        // the slot header precedes the user memory, its next offset gives the size of the slot.
+        // Neighbouring slot updates made with the Allocator::mutex held only ever modify the header's previous offset, and do so
+        // atomically, so the next offset is stable while the slot is allocated and can be read atomically without locking.
+        auto slot = static_cast<const MemoryBlock::Element*>(ptr)[-1].atomicLoad();
+        size_t slotSize = sizeof(MemoryBlock::Element) * (static_cast<size_t>(slot.next) - 1);
+
+        // bin into the largest size class that fits within the slot
+        size_t sizeClassCount = slotSize / sizeClassGranularity;
+        if (sizeClassCount == 0 || sizeClassCount > numSizeClasses) return false;
+
+        auto& slots = magazine(block->affinity, sizeClassCount - 1);
+        slots.push_back(ptr);
+
+        if (slots.size() > allocator->threadCacheSize)
+        {
+            std::scoped_lock<std::mutex> lock(allocator->mutex);
+            drain(slots, slots.size() - allocator->threadCacheSize / 2);
+        }
+
+        return true;
+    }
+
+    /// return the oldest count slots to their MemoryBlock, must be called with the Allocator::mutex held.
+    void drain(Magazine& slots, size_t count)
+    {
+        auto end = slots.begin() + static_cast<std::ptrdiff_t>(std::min(count, slots.size()));
+        for (auto itr = slots.begin(); itr != end; ++itr)
+        {
+            if (auto block = allocator->memoryBlockIndex.find(*itr)) block->deallocate(*itr, 0);
+        }
+        slots.erase(slots.begin(), end);
+    }
+
+    /// return all cached slots, must be called with the Allocator::mutex held.
+    void clear()
+    {
+        for (auto& magazines : affinityMagazines)
+        {
+            for (auto& slots : magazines) drain(slots, slots.size());
+        }
+    }
+};
+
+namespace
+{
+    // trivially destructible so remains safe to access for deallocations made during thread exit
+    thread_local IntrusiveAllocator::ThreadCache* t_threadCache = nullptr;
+    thread_local bool t_threadExiting = false;
+
+    struct ThreadCacheCleanup
+    {
+        ~ThreadCacheCleanup()
+        {
+            t_threadExiting = true;
+            delete t_threadCache;
+            t_threadCache = nullptr;
+        }
+    };
+    thread_local ThreadCacheCleanup t_threadCacheCleanup;
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // IntrusiveAllocator
@@ -851,10 +1149,10 @@ IntrusiveAllocator::IntrusiveAllocator(size_t in_defaultAlignment) :
     size_t blockSize = size_t(1) * Megabyte;
 
     allocatorMemoryBlocks.resize(vsg::ALLOCATOR_AFFINITY_LAST);
-    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_OBJECTS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_OBJECTS", blockSize, defaultAlignment));
-    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_DATA].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_DATA", size_t(16) * blockSize, defaultAlignment));
-    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_NODES].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_NODES", blockSize, defaultAlignment));
-    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_PHYSICS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_PHYSICS", blockSize, 16));
+    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_OBJECTS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_OBJECTS", vsg::ALLOCATOR_AFFINITY_OBJECTS, blockSize, defaultAlignment));
+    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_DATA].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_DATA", vsg::ALLOCATOR_AFFINITY_DATA, size_t(16) * blockSize, defaultAlignment));
+    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_NODES].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_NODES", vsg::ALLOCATOR_AFFINITY_NODES, blockSize, defaultAlignment));
+    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_PHYSICS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_PHYSICS", vsg::ALLOCATOR_AFFINITY_PHYSICS, blockSize, 16));
 }
 
 IntrusiveAllocator::IntrusiveAllocator(std::unique_ptr<Allocator> in_nestedAllocator, size_t in_defaultAlignment) :
@@ -864,14 +1162,45 @@ IntrusiveAllocator::IntrusiveAllocator(std::unique_ptr<Allocator> in_nestedAlloc
     size_t blockSize = size_t(1) * Megabyte;
 
     allocatorMemoryBlocks.resize(vsg::ALLOCATOR_AFFINITY_LAST);
-    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_OBJECTS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_OBJECTS", blockSize, defaultAlignment));
-    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_DATA].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_DATA", size_t(16) * blockSize, defaultAlignment));
-    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_NODES].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_NODES", blockSize, defaultAlignment));
-    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_PHYSICS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_PHYSICS", blockSize, 16));
+    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_OBJECTS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_OBJECTS", vsg::ALLOCATOR_AFFINITY_OBJECTS, blockSize, defaultAlignment));
+    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_DATA].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_DATA", vsg::ALLOCATOR_AFFINITY_DATA, size_t(16) * blockSize, defaultAlignment));
+    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_NODES].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_NODES", vsg::ALLOCATOR_AFFINITY_NODES, blockSize, defaultAlignment));
+    allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_PHYSICS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_PHYSICS", vsg::ALLOCATOR_AFFINITY_PHYSICS, blockSize, 16));
 }
 
 IntrusiveAllocator::~IntrusiveAllocator()
 {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    // detach the thread caches, their slots are released along with the MemoryBlocks
+    for (auto cache : threadCaches) cache->allocator = nullptr;
+}
+
+IntrusiveAllocator::ThreadCache* IntrusiveAllocator::threadCache()
+{
+    if (t_threadCache)
+    {
+        if (t_threadCache->allocator == this) return t_threadCache;
+        if (t_threadCache->allocator) return nullptr;
+
+        // previous allocator has been destroyed so discard its cache
+        delete t_threadCache;
+        t_threadCache = nullptr;
+    }
+
+    if (threadCacheSize == 0 || t_threadExiting) return nullptr;
+
+    // make sure the cleanup is registered so the cache is returned when the thread exits
+    static_cast<void>(&t_threadCacheCleanup);
+
+    auto cache = new ThreadCache(this);
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        threadCaches.push_back(cache);
+    }
+
+    t_threadCache = cache;
+    return cache;
 }
 
 void IntrusiveAllocator::setBlockSize(AllocatorAffinity allocatorAffinity, size_t blockSize)
@@ -887,13 +1216,13 @@ void IntrusiveAllocator::setBlockSize(AllocatorAffinity allocatorAffinity, size_
         auto name = vsg::make_string("MemoryBlocks_", allocatorAffinity);
 
         allocatorMemoryBlocks.resize(allocatorAffinity + 1);
-        allocatorMemoryBlocks[allocatorAffinity].reset(new MemoryBlocks(this, name, blockSize, defaultAlignment));
+        allocatorMemoryBlocks[allocatorAffinity].reset(new MemoryBlocks(this, name, allocatorAffinity, blockSize, defaultAlignment));
     }
 }
 
 void IntrusiveAllocator::report(std::ostream& out) const
 {
-    out << "IntrusiveAllocator::report() " << allocatorMemoryBlocks.size() << std::endl;
+    out << "IntrusiveAllocator::report() " << allocatorMemoryBlocks.size() << ", threadCaches.size() = " << threadCaches.size() << std::endl;
 
     for (const auto& memoryBlock : allocatorMemoryBlocks)
     {
@@ -905,6 +1234,12 @@ void IntrusiveAllocator::report(std::ostream& out) const
 
 void* IntrusiveAllocator::allocate(std::size_t size, AllocatorAffinity allocatorAffinity)
 {
+    auto cache = (size <= ThreadCache::maximumCachedSize) ? threadCache() : nullptr;
+    if (cache)
+    {
+        if (auto ptr = cache->allocate(size, allocatorAffinity)) return ptr;
+    }
+
     std::scoped_lock<std::mutex> lock(mutex);
 
     // create a MemoryBlocks entry if one doesn't already exist
@@ -912,7 +1247,7 @@ void* IntrusiveAllocator::allocate(std::size_t size, AllocatorAffinity allocator
     {
         size_t blockSize = 1024 * 1024; // Megabyte
         allocatorMemoryBlocks.resize(allocatorAffinity + 1);
-        allocatorMemoryBlocks[allocatorAffinity].reset(new MemoryBlocks(this, "MemoryBlockAffinity", blockSize, defaultAlignment));
+        allocatorMemoryBlocks[allocatorAffinity].reset(new MemoryBlocks(this, "MemoryBlockAffinity", allocatorAffinity, blockSize, defaultAlignment));
     }
 
     void* ptr = nullptr;
@@ -922,7 +1257,7 @@ void* IntrusiveAllocator::allocate(std::size_t size, AllocatorAffinity allocator
     {
         if (size <= blocks->maximumAllocationSize)
         {
-            ptr = blocks->allocate(size);
+            ptr = cache ? cache->refill(*blocks, size, allocatorAffinity) : blocks->allocate(size);
             if (ptr) return ptr;
             //std::cout<<"IntrusiveAllocator::allocate() Failed to allocator memory from memoryBlocks "<<blocks.get()<<std::endl;
         }
@@ -941,6 +1276,15 @@ void* IntrusiveAllocator::allocate(std::size_t size, AllocatorAffinity allocator
 
 bool IntrusiveAllocator::deallocate(void* ptr, std::size_t size)
 {
+    if (auto block = memoryBlockIndex.find(ptr))
+    {
+        auto cache = threadCache();
+        if (cache && cache->deallocate(ptr, block)) return true;
+
+        std::scoped_lock<std::mutex> lock(mutex);
+        return block->deallocate(ptr, size);
+    }
+
     std::scoped_lock<std::mutex> lock(mutex);
 
     if (memoryBlocks.empty()) return false;
@@ -1005,6 +1349,11 @@ bool IntrusiveAllocator::validate() const
 
 size_t IntrusiveAllocator::deleteEmptyMemoryBlocks()
 {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    // return the slots cached by this thread so their MemoryBlocks can be recognized as empty
+    if (t_threadCache && t_threadCache->allocator == this) t_threadCache->clear();
+
     size_t count = 0;
     for (auto& blocks : allocatorMemoryBlocks)
     {
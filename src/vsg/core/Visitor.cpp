@@ -614,6 +614,14 @@ void Visitor::apply(CullNode& value)
 {
     apply(static_cast<Node&>(value));
 }
+void Visitor::apply(BatchCullGroup& value)
+{
+    apply(static_cast<Node&>(value));
+}
+void Visitor::apply(Occluder& value)
+{
+    apply(static_cast<Group&>(value));
+}
 void Visitor::apply(Transform& value)
 {
     apply(static_cast<Group&>(value));
@@ -0,0 +1,296 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Exception.h>
+#include <vsg/io/AsyncLogger.h>
+#include <vsg/io/FileSystem.h>
+
+#include <sstream>
+
+using namespace vsg;
+
+AsyncLogger::AsyncLogger(ref_ptr<Logger> in_sink, size_t capacity) :
+    _sink(in_sink)
+{
+    if (!_sink)
+    {
+        _sink = StdLogger::create();
+        _sink->level = LOGGER_ALL;
+    }
+
+    _start(capacity);
+}
+
+AsyncLogger::AsyncLogger(const Path& filename, size_t capacity)
+{
+    _file = vsg::fopen(filename, "w");
+    if (!_file)
+    {
+        _sink = StdLogger::create();
+        _sink->level = LOGGER_ALL;
+        _sink->warn("AsyncLogger could not open ", filename, ", writing to StdLogger instead.");
+    }
+
+    _start(capacity);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    _active = false;
+    _wakeCondition.notify_one();
+    if (_thread.joinable()) _thread.join();
+
+    if (_file) fclose(_file);
+}
+
+void AsyncLogger::_start(size_t capacity)
+{
+    // messages are pushed from multiple threads so the *_implementation() methods don't require Logger::_mutex
+    _threadSafeImplementation = true;
+
+    // round capacity up to a power of two so ring positions can be masked
+    _capacity = 2;
+    while (_capacity < capacity) _capacity <<= 1;
+
+    _slots.reset(new Slot[_capacity]);
+    for (uint64_t i = 0; i < _capacity; ++i) _slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    _startTime = clock::now();
+    _thread = std::thread([this]() { _run(); });
+}
+
+void AsyncLogger::setThreadName(std::thread::id id, const std::string& name)
+{
+    std::scoped_lock<std::mutex> lock(_threadNamesMutex);
+    _threadNames[id] = name;
+}
+
+bool AsyncLogger::_push(Level msg_level, const std::string_view& message, bool block)
+{
+    bool blocked = false;
+    auto position = _enqueuePosition.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        auto& slot = _slots[position & (_capacity - 1)];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequence - position);
+        if (diff == 0)
+        {
+            // slot is free, claim it
+            if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                // count the message before publishing it so that flush() never sees it written but not logged
+                ++_numLogged;
+
+                slot.record.level = msg_level;
+                slot.record.threadID = std::this_thread::get_id();
+                slot.record.time = clock::now();
+                slot.record.message.assign(message.data(), message.size()); // reuses the slot's string capacity
+                slot.sequence.store(position + 1, std::memory_order_release);
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // ring is full
+            if (!block)
+            {
+                ++_numDropped;
+                return false;
+            }
+
+            // wake the background thread and wait for it to signal that it has made space, rather than spinning,
+            // with the timeout as a backstop against a missed notification
+            blocked = true;
+            ++_numSpaceWaiting;
+            {
+                std::unique_lock<std::mutex> lock(_spaceMutex);
+                _wakeCondition.notify_one();
+                _spaceCondition.wait_for(lock, writeInterval, [&]() {
+                    return static_cast<int64_t>(slot.sequence.load(std::memory_order_acquire) - position) >= 0;
+                });
+            }
+            --_numSpaceWaiting;
+            position = _enqueuePosition.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            // another thread claimed the slot first
+            position = _enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (blocked) ++_numBlocked;
+
+    if (_sleeping.load(std::memory_order_relaxed)) _wakeCondition.notify_one();
+    return true;
+}
+
+bool AsyncLogger::_pop(Record& record)
+{
+    auto& slot = _slots[_dequeuePosition & (_capacity - 1)];
+    auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<int64_t>(sequence - (_dequeuePosition + 1)) < 0) return false;
+
+    // swap rather than copy so string capacity circulates between the slots and the background thread
+    record.level = slot.record.level;
+    record.threadID = slot.record.threadID;
+    record.time = slot.record.time;
+    record.message.swap(slot.record.message);
+
+    slot.sequence.store(_dequeuePosition + _capacity, std::memory_order_release);
+    ++_dequeuePosition;
+    return true;
+}
+
+void AsyncLogger::_write(const Record& record)
+{
+    double time = std::chrono::duration<double>(record.time - _startTime).count();
+
+    bool named = false;
+    {
+        // copy the name while holding the lock as setThreadName() may reassign it, assigning to _threadName reuses its capacity
+        std::scoped_lock<std::mutex> lock(_threadNamesMutex);
+        if (auto itr = _threadNames.find(record.threadID); itr != _threadNames.end())
+        {
+            _threadName = itr->second;
+            named = true;
+        }
+    }
+
+    if (!named)
+    {
+        // format unnamed threads on the fly so _threadNames only holds the names assigned by setThreadName()
+        _threadIDStream.str({});
+        _threadIDStream.clear();
+        _threadIDStream << "thread::id = " << record.threadID;
+        _threadName = _threadIDStream.str();
+    }
+
+    if (_file)
+    {
+        const std::string* prefix = &infoPrefix;
+        switch (record.level)
+        {
+        case (LOGGER_DEBUG): prefix = &debugPrefix; break;
+        case (LOGGER_WARN): prefix = &warnPrefix; break;
+        case (LOGGER_ERROR): prefix = &errorPrefix; break;
+        case (LOGGER_FATAL): prefix = &fatalPrefix; break;
+        default: break;
+        }
+
+        fprintf(_file, "[%.6f] %s | %s%.*s\n", time, _threadName.c_str(), prefix->c_str(), static_cast<int>(record.message.length()), record.message.data());
+    }
+    else if (_sink)
+    {
+        // the sink applies its own level prefix
+        _line.clear();
+        _line.append("[");
+        _line.append(std::to_string(time));
+        _line.append("] ");
+        _line.append(_threadName);
+        _line.append(" | ");
+        _line.append(record.message);
+
+        // fatal messages are written as errors as the sink may throw, the exception is thrown by the logging thread
+        _sink->log(record.level == LOGGER_FATAL ? LOGGER_ERROR : record.level, _line);
+    }
+}
+
+void AsyncLogger::_run()
+{
+    Record record;
+    for (;;)
+    {
+        uint64_t numWritten = 0;
+        while (_pop(record))
+        {
+            // let producers blocked on a full ring continue as soon as a slot is free
+            if (_numSpaceWaiting.load() > 0)
+            {
+                std::scoped_lock<std::mutex> lock(_spaceMutex);
+                _spaceCondition.notify_all();
+            }
+
+            _write(record);
+            ++numWritten;
+        }
+
+        if (numWritten > 0)
+        {
+            _numWritten += numWritten;
+
+            if (_numFlushWaiting.load() > 0)
+            {
+                std::scoped_lock<std::mutex> lock(_flushMutex);
+                _flushCondition.notify_all();
+            }
+            continue;
+        }
+
+        if (!_active) break;
+
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _sleeping = true;
+        _wakeCondition.wait_for(lock, writeInterval);
+        _sleeping = false;
+    }
+
+    if (_file) fflush(_file);
+    if (_sink) _sink->flush();
+}
+
+void AsyncLogger::flush()
+{
+    auto numLogged = _numLogged.load();
+    if (_numWritten.load() < numLogged)
+    {
+        // wait for the background thread to signal that it has written all the messages logged so far
+        std::unique_lock<std::mutex> lock(_flushMutex);
+        ++_numFlushWaiting;
+        _wakeCondition.notify_one();
+        _flushCondition.wait(lock, [&]() { return _numWritten.load() >= numLogged; });
+        --_numFlushWaiting;
+    }
+
+    if (_file) fflush(_file);
+    if (_sink) _sink->flush();
+}
+
+void AsyncLogger::debug_implementation(const std::string_view& message)
+{
+    _push(LOGGER_DEBUG, message, overflowPolicy == OVERFLOW_BLOCK);
+}
+
+void AsyncLogger::info_implementation(const std::string_view& message)
+{
+    _push(LOGGER_INFO, message, overflowPolicy == OVERFLOW_BLOCK);
+}
+
+void AsyncLogger::warn_implementation(const std::string_view& message)
+{
+    _push(LOGGER_WARN, message, overflowPolicy == OVERFLOW_BLOCK);
+}
+
+void AsyncLogger::error_implementation(const std::string_view& message)
+{
+    _push(LOGGER_ERROR, message, overflowPolicy == OVERFLOW_BLOCK);
+}
+
+void AsyncLogger::fatal_implementation(const std::string_view& message)
+{
+    // make sure fatal messages are written before throwing
+    _push(LOGGER_FATAL, message, true);
+    flush();
+
+    throw Exception{std::string(message)};
+}
@@ -10,20 +10,275 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/Inherit.h>
 #include <vsg/io/BinaryInput.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/ReaderWriter.h>
+#include <vsg/threading/Latch.h>
 
 #include <cstring>
+#include <typeinfo>
 
 using namespace vsg;
 
+namespace
+{
+    /// decompress a chunk read by BinaryInput::decompressChunks(), run in parallel on the OperationThreads
+    struct DecompressChunk : public Inherit<Operation, DecompressChunk>
+    {
+        DecompressChunk(const ChunkIndexEntry& in_entry, const std::vector<uint8_t>& in_compressed, std::vector<uint8_t>& in_decompressed, ref_ptr<Latch> in_latch) :
+            entry(in_entry), compressed(in_compressed), decompressed(in_decompressed), latch(in_latch) {}
+
+        const ChunkIndexEntry& entry;
+        const std::vector<uint8_t>& compressed;
+        std::vector<uint8_t>& decompressed;
+        ref_ptr<Latch> latch;
+
+        void run() override
+        {
+            if (!decompress(static_cast<CompressionCodec>(entry.codec), compressed.data(), compressed.size(), decompressed.data(), decompressed.size()))
+            {
+                // leave the chunk to be decompressed, and any error reported, when it's read
+                std::vector<uint8_t>().swap(decompressed);
+            }
+            if (latch) latch->count_down();
+        }
+    };
+} // namespace
+
 BinaryInput::BinaryInput(std::istream& input, ref_ptr<ObjectFactory> in_objectFactory, ref_ptr<const Options> in_options) :
     Input(in_objectFactory, in_options),
     _input(input)
 {
 }
 
+void BinaryInput::_skipPadding()
+{
+    auto position = static_cast<size_t>(_input.tellg() - alignmentOrigin);
+    if (auto padding = (alignment - position % alignment) % alignment; padding != 0)
+    {
+        _input.seekg(static_cast<std::streamoff>(padding), std::ios_base::cur);
+    }
+}
+
+void BinaryInput::_readBytes(void* ptr, size_t size)
+{
+    if (chunkThreshold != 0 && size >= chunkThreshold)
+    {
+        _readChunk(ptr, size);
+        return;
+    }
+
+    if (alignment != 0 && size >= alignmentThreshold) _skipPadding();
+    _input.read(reinterpret_cast<char*>(ptr), size);
+}
+
+void BinaryInput::_readChunk(void* ptr, size_t size)
+{
+    uint32_t chunkIndex = 0;
+    uint32_t codec = COMPRESSION_NONE;
+    uint64_t compressedSize = 0;
+    _input.read(reinterpret_cast<char*>(&chunkIndex), sizeof(chunkIndex));
+    _input.read(reinterpret_cast<char*>(&codec), sizeof(codec));
+    _input.read(reinterpret_cast<char*>(&compressedSize), sizeof(compressedSize));
+    if (!_input)
+    {
+        std::memset(ptr, 0, size);
+        return;
+    }
+
+    // use the chunk if it's already been decompressed by decompressChunks(), releasing it as each chunk is only read once
+    if (chunkIndex < _decompressedChunks.size() && _decompressedChunks[chunkIndex].size() == size)
+    {
+        std::memcpy(ptr, _decompressedChunks[chunkIndex].data(), size);
+        std::vector<uint8_t>().swap(_decompressedChunks[chunkIndex]);
+        _input.seekg(static_cast<std::streamoff>(compressedSize), std::ios_base::cur);
+        return;
+    }
+
+    // check the chunk header against the chunk index when it's been read, otherwise bound the compressed size by what the codec could
+    // produce for size bytes and by the remaining stream length, so a corrupt header can't trigger a huge allocation
+    bool validChunk = true;
+    if (chunkIndex < _chunkIndex.size())
+    {
+        const auto& entry = _chunkIndex[chunkIndex];
+        validChunk = entry.codec == codec && entry.compressedSize == compressedSize && entry.size == size;
+    }
+    else
+    {
+        validChunk = (codec == COMPRESSION_NONE) ? (compressedSize == size) : (compressedSize <= size + size / 128 + 1024);
+        if (auto position = _input.tellg(); validChunk && position != std::istream::pos_type(-1))
+        {
+            _input.seekg(0, std::ios_base::end);
+            auto end = _input.tellg();
+            _input.clear();
+            _input.seekg(position);
+            validChunk = _input && end != std::istream::pos_type(-1) && compressedSize <= static_cast<uint64_t>(end - position);
+        }
+    }
+
+    if (!validChunk)
+    {
+        warn("BinaryInput invalid chunk ", chunkIndex, ", codec = ", codec, ", compressedSize = ", compressedSize, ", size = ", size);
+        std::memset(ptr, 0, size);
+        _input.setstate(std::ios_base::failbit);
+        return;
+    }
+
+    if (codec == COMPRESSION_NONE)
+    {
+        _input.read(reinterpret_cast<char*>(ptr), size);
+        return;
+    }
+
+    _compressedBuffer.resize(compressedSize);
+    _input.read(reinterpret_cast<char*>(_compressedBuffer.data()), static_cast<std::streamsize>(compressedSize));
+    if (!decompress(static_cast<CompressionCodec>(codec), _compressedBuffer.data(), compressedSize, ptr, size))
+    {
+        warn("BinaryInput unable to decompress chunk ", chunkIndex, ", codec = ", codec, ", compressionSupported = ", compressionSupported(static_cast<CompressionCodec>(codec)));
+        std::memset(ptr, 0, size);
+    }
+}
+
+bool BinaryInput::decompressChunks(ref_ptr<OperationThreads> operationThreads)
+{
+    if (chunkThreshold == 0) return false;
+
+    // non-seekable streams can't access the footer so leave the chunks to be decompressed sequentially as they are read
+    auto position = _input.tellg();
+    if (position == std::istream::pos_type(-1))
+    {
+        _input.clear();
+        return false;
+    }
+
+    // footer is the chunk index entries followed by the index offset, number of chunks and the "VSGC" tag
+    uint64_t indexOffset = 0;
+    uint32_t numChunks = 0;
+    char tag[4] = {};
+    constexpr size_t footerSize = sizeof(indexOffset) + sizeof(numChunks) + sizeof(tag);
+
+    _input.seekg(0, std::ios_base::end);
+    auto end = _input.tellg();
+    if (!_input || static_cast<size_t>(end - alignmentOrigin) < footerSize)
+    {
+        _input.clear();
+        _input.seekg(position);
+        return false;
+    }
+
+    _input.seekg(end - static_cast<std::streamoff>(footerSize));
+    _input.read(reinterpret_cast<char*>(&indexOffset), sizeof(indexOffset));
+    _input.read(reinterpret_cast<char*>(&numChunks), sizeof(numChunks));
+    _input.read(tag, sizeof(tag));
+
+    if (!_input || std::strncmp(tag, "VSGC", 4) != 0)
+    {
+        _input.clear();
+        _input.seekg(position);
+        return false;
+    }
+
+    // validate the footer against the file size before allocating anything based on it, the index must fit between indexOffset and the footer
+    uint64_t footerOffset = static_cast<uint64_t>(end - alignmentOrigin) - footerSize;
+    if (indexOffset > footerOffset || numChunks > (footerOffset - indexOffset) / sizeof(ChunkIndexEntry))
+    {
+        warn("BinaryInput invalid chunk index, indexOffset = ", indexOffset, ", numChunks = ", numChunks);
+        _input.clear();
+        _input.seekg(position);
+        return false;
+    }
+
+    auto& chunkIndex = _chunkIndex;
+    chunkIndex.resize(numChunks);
+    _input.seekg(alignmentOrigin + static_cast<std::streamoff>(indexOffset));
+    _input.read(reinterpret_cast<char*>(chunkIndex.data()), numChunks * sizeof(ChunkIndexEntry));
+
+    // the chunks must all lie before the index
+    bool validIndex = static_cast<bool>(_input);
+    for (auto& entry : chunkIndex)
+    {
+        if (entry.offset > indexOffset || entry.compressedSize > indexOffset - entry.offset)
+        {
+            validIndex = false;
+            break;
+        }
+    }
+
+    if (!validIndex)
+    {
+        chunkIndex.clear();
+        warn("BinaryInput invalid chunk index entries, falling back to decompressing chunks as they are read.");
+        _input.clear();
+        _input.seekg(position);
+        return false;
+    }
+
+    // read the compressed chunks sequentially as the stream can't be shared between threads, uncompressed chunks are read in place later
+    std::vector<std::vector<uint8_t>> compressedChunks(numChunks);
+    _decompressedChunks.resize(numChunks);
+    for (uint32_t i = 0; i < numChunks; ++i)
+    {
+        auto& entry = chunkIndex[i];
+        if (entry.codec == COMPRESSION_NONE) continue;
+
+        compressedChunks[i].resize(entry.compressedSize);
+        _input.seekg(alignmentOrigin + static_cast<std::streamoff>(entry.offset));
+        _input.read(reinterpret_cast<char*>(compressedChunks[i].data()), static_cast<std::streamsize>(entry.compressedSize));
+        _decompressedChunks[i].resize(entry.size);
+    }
+
+    _input.clear();
+    _input.seekg(position);
+
+    if (operationThreads)
+    {
+        size_t numCompressed = 0;
+        for (auto& entry : chunkIndex)
+        {
+            if (entry.codec != COMPRESSION_NONE) ++numCompressed;
+        }
+
+        auto latch = Latch::create(numCompressed);
+        for (uint32_t i = 0; i < numChunks; ++i)
+        {
+            if (chunkIndex[i].codec == COMPRESSION_NONE) continue;
+            operationThreads->add(DecompressChunk::create(chunkIndex[i], compressedChunks[i], _decompressedChunks[i], latch));
+        }
+
+        operationThreads->run();
+        latch->wait();
+    }
+    else
+    {
+        for (uint32_t i = 0; i < numChunks; ++i)
+        {
+            if (chunkIndex[i].codec == COMPRESSION_NONE) continue;
+            DecompressChunk::create(chunkIndex[i], compressedChunks[i], _decompressedChunks[i], ref_ptr<Latch>())->run();
+        }
+    }
+
+    return true;
+}
+
+std::pair<ref_ptr<Data>, size_t> BinaryInput::readMapped(size_t size, size_t valueAlignment)
+{
+    // chunked values aren't stored in place so can't be mapped
+    if (chunkThreshold != 0 && size >= chunkThreshold) return {};
+
+    if (!mappedData || size < minimumMappedSize) return {};
+
+    if (alignment != 0 && size >= alignmentThreshold) _skipPadding();
+
+    auto offset = static_cast<size_t>(_input.tellg());
+    auto address = reinterpret_cast<uintptr_t>(mappedData->dataPointer(offset));
+    if ((address % valueAlignment) != 0 || (offset + size) > mappedData->dataSize()) return {};
+
+    _input.seekg(static_cast<std::streamoff>(size), std::ios_base::cur);
+
+    return {mappedData, offset};
+}
+
 void BinaryInput::_read(std::string& value)
 {
     uint32_t size = readValue<uint32_t>(nullptr);
@@ -136,7 +391,7 @@ void BinaryInput::read(size_t num, long double* value)
         {
             std::vector<double_128> data(num);
 
-            _input.read(reinterpret_cast<char*>(data.data()), num * sizeof(double_128));
+            _readBytes(data.data(), num * sizeof(double_128));
 
             if (native_type == 64)
             {
@@ -181,34 +436,112 @@ void BinaryInput::read(size_t num, long double* value)
     }
 }
 
+void BinaryInput::_assign(ObjectID id, ref_ptr<Object> object)
+{
+    // guard against corrupt IDs allocating huge vectors
+    constexpr size_t maxDenseGap = 65536;
+    if (id < _objects.size() + maxDenseGap)
+    {
+        if (id >= _objects.size())
+        {
+            _objects.resize(id + 1);
+            _objectAssigned.resize(id + 1, false);
+        }
+        _objects[id] = object;
+        _objectAssigned[id] = true;
+    }
+    else
+    {
+        objectIDMap[id] = object;
+    }
+}
+
+ref_ptr<Object> BinaryInput::_create(uint32_t classIndex)
+{
+    // index 0 is reserved for nullptr
+    if (_classes.empty()) _classes.emplace_back();
+
+    if (classIndex == _classes.size())
+    {
+        // first use of a class so its name follows, look up the create function once for all the objects of this class.
+        // A subclassed ObjectFactory may override create(), in which case it's always used.
+        ClassEntry entry;
+        _read(entry.className);
+
+        if (typeid(*objectFactory) == typeid(ObjectFactory))
+        {
+            auto& createMap = objectFactory->getCreateMap();
+            if (auto itr = createMap.find(entry.className); itr != createMap.end()) entry.create = itr->second;
+        }
+
+        _classes.push_back(entry);
+    }
+    else if (classIndex > _classes.size())
+    {
+        warn("BinaryInput invalid class index : ", classIndex);
+        return {};
+    }
+
+    auto& entry = _classes[classIndex];
+    if (entry.create) return entry.create();
+
+    return objectFactory->create(entry.className);
+}
+
 vsg::ref_ptr<vsg::Object> BinaryInput::read()
 {
     ObjectID id = objectID();
 
+    if (id < _objects.size() && _objectAssigned[id])
+    {
+        return _objects[id];
+    }
+
     if (auto itr = objectIDMap.find(id); itr != objectIDMap.end())
     {
         return itr->second;
     }
-    else
+
+    if (classTable)
     {
-        std::string className = readValue<std::string>(nullptr);
-        if (className != "nullptr")
+        uint32_t classIndex = readValue<uint32_t>(nullptr);
+        if (classIndex == 0)
         {
-            auto object = objectFactory->create(className.c_str());
-            objectIDMap[id] = object;
-            if (object)
-            {
-                object->read(*this);
-            }
-            else
-            {
-                warn("Unable to create instance of class : ", className);
-            }
-            return object;
+            _assign(id, {});
+            return {};
+        }
+
+        auto object = _create(classIndex);
+        _assign(id, object);
+        if (object)
+        {
+            object->read(*this);
+        }
+        else if (classIndex < _classes.size())
+        {
+            warn("Unable to create instance of class : ", _classes[classIndex].className);
+        }
+        return object;
+    }
+
+    std::string className = readValue<std::string>(nullptr);
+    if (className != "nullptr")
+    {
+        auto object = objectFactory->create(className.c_str());
+        _assign(id, object);
+        if (object)
+        {
+            object->read(*this);
         }
         else
         {
-            return objectIDMap[id] = {};
+            warn("Unable to create instance of class : ", className);
         }
+        return object;
+    }
+    else
+    {
+        _assign(id, {});
+        return {};
     }
 }
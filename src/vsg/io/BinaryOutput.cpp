@@ -22,6 +22,68 @@ BinaryOutput::BinaryOutput(std::ostream& output, ref_ptr<const Options> in_optio
 {
 }
 
+void BinaryOutput::_writePadding()
+{
+    auto position = static_cast<size_t>(_output.tellp() - alignmentOrigin);
+    if (auto padding = (alignment - position % alignment) % alignment; padding != 0)
+    {
+        const char zeros[256] = {};
+        for (; padding > sizeof(zeros); padding -= sizeof(zeros)) _output.write(zeros, sizeof(zeros));
+        _output.write(zeros, padding);
+    }
+}
+
+void BinaryOutput::_writeBytes(const void* ptr, size_t size)
+{
+    if (chunkThreshold != 0 && size >= chunkThreshold)
+    {
+        _writeChunk(ptr, size);
+        return;
+    }
+
+    if (alignment != 0 && size >= alignmentThreshold) _writePadding();
+    _output.write(reinterpret_cast<const char*>(ptr), size);
+}
+
+void BinaryOutput::_writeChunk(const void* ptr, size_t size)
+{
+    ChunkIndexEntry entry;
+    entry.compressedSize = size;
+    entry.size = size;
+
+    const void* payload = ptr;
+    if (compressionCodec != COMPRESSION_NONE && compress(compressionCodec, ptr, size, _compressionBuffer, compressionLevel) && _compressionBuffer.size() < size)
+    {
+        payload = _compressionBuffer.data();
+        entry.compressedSize = _compressionBuffer.size();
+        entry.codec = compressionCodec;
+    }
+
+    // the chunk header is written inline so the chunk can be read sequentially without the footer index
+    uint32_t chunkIndex = static_cast<uint32_t>(_chunkIndex.size());
+    _output.write(reinterpret_cast<const char*>(&chunkIndex), sizeof(chunkIndex));
+    _output.write(reinterpret_cast<const char*>(&entry.codec), sizeof(entry.codec));
+    _output.write(reinterpret_cast<const char*>(&entry.compressedSize), sizeof(entry.compressedSize));
+
+    entry.offset = static_cast<uint64_t>(_output.tellp() - alignmentOrigin);
+    _output.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(entry.compressedSize));
+
+    _chunkIndex.push_back(entry);
+}
+
+void BinaryOutput::writeChunkIndex()
+{
+    if (chunkThreshold == 0) return;
+
+    // footer is the chunk index entries followed by the index offset, number of chunks and the "VSGC" tag
+    uint64_t indexOffset = static_cast<uint64_t>(_output.tellp() - alignmentOrigin);
+    uint32_t numChunks = static_cast<uint32_t>(_chunkIndex.size());
+    if (numChunks > 0) _output.write(reinterpret_cast<const char*>(_chunkIndex.data()), numChunks * sizeof(ChunkIndexEntry));
+    _output.write(reinterpret_cast<const char*>(&indexOffset), sizeof(indexOffset));
+    _output.write(reinterpret_cast<const char*>(&numChunks), sizeof(numChunks));
+    _output.write("VSGC", 4);
+}
+
 void BinaryOutput::_write(const std::string& str)
 {
     uint32_t size = static_cast<uint32_t>(str.size());
@@ -102,6 +164,29 @@ void BinaryOutput::write(const vsg::Object* object)
     objectIDMap[object] = id;
 
     _output.write(reinterpret_cast<const char*>(&id), sizeof(id));
+
+    if (classTable)
+    {
+        uint32_t classIndex = 0;
+        if (object)
+        {
+            auto className = object->className();
+            auto [itr, inserted] = _classIndices.emplace(className, static_cast<uint32_t>(_classIndices.size() + 1));
+            classIndex = itr->second;
+
+            // the first use of a class writes its name straight after the new index
+            _output.write(reinterpret_cast<const char*>(&classIndex), sizeof(classIndex));
+            if (inserted) _write(std::string(className));
+
+            object->write(*this);
+        }
+        else
+        {
+            _output.write(reinterpret_cast<const char*>(&classIndex), sizeof(classIndex));
+        }
+        return;
+    }
+
     if (object)
     {
         _write(std::string(object->className()));
@@ -377,99 +377,246 @@ DatabaseQueue::~DatabaseQueue()
 {
 }
 
+void DatabaseQueue::_siftUp(size_t position)
+{
+    while (position > 0)
+    {
+        size_t parent = (position - 1) / 2;
+        if (_available[parent].priority >= _available[position].priority) break;
+
+        std::swap(_available[parent], _available[position]);
+        _availableIndices[_available[position].plod.get()] = position;
+        position = parent;
+    }
+    _availableIndices[_available[position].plod.get()] = position;
+}
+
+void DatabaseQueue::_siftDown(size_t position)
+{
+    size_t size = _available.size();
+    for (;;)
+    {
+        size_t highest = position;
+        size_t left = position * 2 + 1;
+        size_t right = left + 1;
+        if (left < size && _available[left].priority > _available[highest].priority) highest = left;
+        if (right < size && _available[right].priority > _available[highest].priority) highest = right;
+        if (highest == position) break;
+
+        std::swap(_available[highest], _available[position]);
+        _availableIndices[_available[position].plod.get()] = position;
+        position = highest;
+    }
+    _availableIndices[_available[position].plod.get()] = position;
+}
+
+void DatabaseQueue::_removeAt(size_t position)
+{
+    _availableIndices.erase(_available[position].plod.get());
+
+    size_t last = _available.size() - 1;
+    if (position != last)
+    {
+        _available[position] = std::move(_available[last]);
+        _available.pop_back();
+
+        if (position > 0 && _available[position].priority > _available[(position - 1) / 2].priority)
+            _siftUp(position);
+        else
+            _siftDown(position);
+    }
+    else
+    {
+        _available.pop_back();
+    }
+}
+
+void DatabaseQueue::_push(ref_ptr<PagedLOD> plod)
+{
+    auto itr = _availableIndices.find(plod.get());
+    if (itr != _availableIndices.end())
+    {
+        // already queued so just reflect any change in priority
+        auto& entry = _available[itr->second];
+        entry.priority = plod->priority.load();
+        _siftUp(itr->second);
+        return;
+    }
+
+    auto frameNextLoadAttempt = plod->frameNextLoadAttempt.load();
+
+    // remove any previous deferred entry so each PagedLOD is only held once
+    if (auto deferred_itr = _deferredIndices.find(plod.get()); deferred_itr != _deferredIndices.end())
+    {
+        if (deferred_itr->second->first.first == frameNextLoadAttempt && frameNextLoadAttempt > _frameCount) return;
+
+        _deferred.erase(deferred_itr->second);
+        _deferredIndices.erase(deferred_itr);
+    }
+
+    if (frameNextLoadAttempt > _frameCount)
+    {
+        _deferredIndices[plod.get()] = _deferred.emplace(DeferredKey(frameNextLoadAttempt, _deferredSequence++), plod).first;
+        return;
+    }
+
+    double priority = plod->priority.load();
+    _available.push_back(Entry{plod, priority});
+    _siftUp(_available.size() - 1);
+}
+
+ref_ptr<PagedLOD> DatabaseQueue::_pop()
+{
+    ref_ptr<PagedLOD> plod = _available.front().plod;
+    _removeAt(0);
+    return plod;
+}
+
+void DatabaseQueue::_promoteDeferred(uint64_t frameCount)
+{
+    _frameCount = std::max(_frameCount, frameCount);
+
+    while (!_deferred.empty() && _deferred.begin()->first.first <= _frameCount)
+    {
+        auto plod = _deferred.begin()->second;
+        _deferredIndices.erase(plod.get());
+        _deferred.erase(_deferred.begin());
+        _push(plod);
+    }
+}
+
+void DatabaseQueue::_expire(PagedLOD* plod)
+{
+    // info("pruning ", plod, ", lastUsed = ", plod->frameHighResLastUsed.load(), " vs ", _frameCount, " after ", plod->loadAttempts.load(), " loadAttempts");
+    plod->requestCount.exchange(0);
+    plod->requestStatus.exchange(PagedLOD::NoRequest);
+    ++_numExpired;
+}
+
 void DatabaseQueue::add(ref_ptr<PagedLOD> plod)
 {
     // debug("DatabaseQueue::add(", plod,") status = ",plod->requestStatus.load());
 
     std::scoped_lock lock(_mutex);
-    _queue.emplace_back(plod);
+    _push(plod);
     _cv.notify_one();
 }
 
 void DatabaseQueue::add(ref_ptr<PagedLOD> plod, const CompileResult& cr)
 {
     std::scoped_lock lock(_mutex);
-    _queue.emplace_back(plod);
+    _push(plod);
     _cv.notify_one();
     _compileResult.add(cr);
 }
 
+void DatabaseQueue::updatePriority(const PagedLOD* plod)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto itr = _availableIndices.find(plod);
+    if (itr == _availableIndices.end()) return;
+
+    // priority only ever increases so the entry can only move towards the top of the heap
+    auto& entry = _available[itr->second];
+    double priority = plod->priority.load();
+    if (priority > entry.priority)
+    {
+        entry.priority = priority;
+        _siftUp(itr->second);
+    }
+}
+
 ref_ptr<PagedLOD> DatabaseQueue::take_when_available(uint64_t frameCount)
 {
-    // debug("DatabaseQueue::take_when_available() A size = ", _queue.size());
+    // debug("DatabaseQueue::take_when_available() A size = ", _available.size());
 
     std::chrono::duration waitDuration = std::chrono::milliseconds(100);
     std::unique_lock lock(_mutex);
 
     // wait until the conditional variable signals that an operation has been added
-    while (_queue.empty() && _status->active())
+    while (_available.empty() && _status->active())
     {
-        // debug("   Waiting on condition variable B size = ", _queue.size());
-        _cv.wait_for(lock, waitDuration);
+        // deferred entries ready for promotion, or waiting on a later frame so return to let the caller pass an updated frameCount
+        if (!_deferred.empty() && _deferred.begin()->first.first <= std::max(_frameCount, frameCount)) break;
+
+        // debug("   Waiting on condition variable B size = ", _available.size());
+        if (_cv.wait_for(lock, waitDuration) == std::cv_status::timeout && !_deferred.empty()) break;
     }
 
     // if the threads we are associated with should no longer be running go for a quick exit and return nothing.
-    if (_queue.empty() || _status->cancel())
+    if ((_available.empty() && _deferred.empty()) || _status->cancel())
     {
         // debug("DatabaseQueue::take_when_available() C empty");
         return {};
     }
 
-    // debug("DatabaseQueue::take_when_available() D ", _queue.size());
-
-    // find the PagedLOD with the highest priority;
-    auto itr = _queue.begin();
-
-    size_t skipped = 0;
-
-    // find first PagedLOD in queue that can be loaded/compiled
-    for (; itr != _queue.end(); ++itr)
-    {
-        if ((*itr)->frameNextLoadAttempt.load() <= frameCount) break;
-        ++skipped;
-    }
+    _promoteDeferred(frameCount);
 
-    if (itr == _queue.end())
+    // take the PagedLOD with the highest priority, discarding any that have expired since they were queued.
+    while (!_available.empty())
     {
-        // info("DatabaseQueue::take_when_available(", frameCount, ") no suitable PagedLOD despite ", _queue.size(), " in queue.");
-        return {};
-    }
-
-    auto highest_itr = itr++;
+        auto plod = _pop();
+        if ((plod->frameHighResLastUsed.load() + 1) < _frameCount)
+        {
+            _expire(plod);
+            continue;
+        }
 
-    // find lowest priority PagedLOD in queue.
-    for (; itr != _queue.end(); ++itr)
-    {
-        if ((*itr)->frameNextLoadAttempt.load() <= frameCount && (*itr)->priority > (*highest_itr)->priority) highest_itr = itr;
+        // info("DatabaseQueue::take_when_available(", frameCount, ") plod = ", plod.get(), std::dec, ", size = ", _available.size());
+        return plod;
     }
 
-    ref_ptr<PagedLOD> plod = *highest_itr;
-    _queue.erase(highest_itr);
-
-    // info("DatabaseQueue::take_when_available(", frameCount, ") plod = ", plod.get(), std::dec, ", size = ", _queue.size(), " after skipping ", skipped);
-    return plod;
+    // info("DatabaseQueue::take_when_available(", frameCount, ") no suitable PagedLOD despite ", _deferred.size(), " deferred in queue.");
+    return {};
 }
 
 uint32_t DatabaseQueue::prune(uint64_t frameCount)
 {
     std::unique_lock lock(_mutex);
 
-    uint32_t numRemoved = 0;
-    for (auto itr = _queue.begin(); itr != _queue.end();)
+    _promoteDeferred(frameCount);
+
+    // check a bounded window of entries each frame, cycling through the whole queue over successive frames.
+    for (uint32_t numChecked = 0; numChecked < maxNumPrunedChecksPerFrame && !_available.empty(); ++numChecked)
     {
-        if (((*itr)->frameHighResLastUsed.load() + 1) < frameCount)
+        if (_pruneCursor >= _available.size()) _pruneCursor = 0;
+
+        auto plod = _available[_pruneCursor].plod;
+        if ((plod->frameHighResLastUsed.load() + 1) < _frameCount)
         {
-            // info("pruning ", *itr, ", lastUsed = ", (*itr)->frameHighResLastUsed.load(), " vs ", frameCount, " after ", (*itr)->loadAttempts.load(), " loadAttempts");
-            ++numRemoved;
-            (*itr)->requestCount.exchange(0);
-            (*itr)->requestStatus.exchange(PagedLOD::NoRequest);
-            itr = _queue.erase(itr);
+            _removeAt(_pruneCursor);
+            _expire(plod);
+        }
+        else
+        {
+            ++_pruneCursor;
+        }
+    }
+
+    // deferred entries that are no longer being used won't be promoted for some time, so check them for expiry as well,
+    // cycling through the deferred entries over successive frames.
+    auto itr = _deferred.lower_bound(_deferredPruneCursor);
+    for (uint32_t numChecked = 0; numChecked < maxNumPrunedChecksPerFrame && !_deferred.empty(); ++numChecked)
+    {
+        if (itr == _deferred.end()) itr = _deferred.begin();
+
+        auto plod = itr->second;
+        if ((plod->frameHighResLastUsed.load() + 1) < _frameCount)
+        {
+            _deferredIndices.erase(plod.get());
+            itr = _deferred.erase(itr);
+            _expire(plod);
         }
         else
         {
             ++itr;
         }
     }
+    _deferredPruneCursor = (itr != _deferred.end()) ? itr->first : DeferredKey{};
+
+    uint32_t numRemoved = _numExpired;
+    _numExpired = 0;
     return numRemoved;
 }
 
@@ -477,7 +624,16 @@ DatabaseQueue::Nodes DatabaseQueue::take_all(CompileResult& cr)
 {
     std::scoped_lock lock(_mutex);
     Nodes nodes;
-    nodes.swap(_queue);
+    while (!_available.empty())
+    {
+        nodes.push_back(_pop());
+    }
+    for (auto& [key, plod] : _deferred)
+    {
+        nodes.push_back(plod);
+    }
+    _deferred.clear();
+    _deferredIndices.clear();
     cr.add(_compileResult);
     _compileResult.reset();
     return nodes;
@@ -643,6 +799,11 @@ void DatabasePager::request(ref_ptr<PagedLOD> plod)
     }
 }
 
+void DatabasePager::updatePriority(const PagedLOD* plod)
+{
+    _requestQueue->updatePriority(plod);
+}
+
 void DatabasePager::requestDiscarded(PagedLOD* plod)
 {
     //std::scoped_lock<std::mutex> lock(pendingPagedLODMutex);
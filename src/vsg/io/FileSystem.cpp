@@ -288,6 +288,15 @@ FILE* vsg::fopen(const Path& path, const char* mode)
 #endif
 }
 
+bool vsg::renameFile(const Path& from, const Path& to)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    return MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return ::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
 #if defined(_MSC_VER) || defined(__MINGW32__)
 // Microsoft API for reading directories
 Paths vsg::getDirectoryContents(const Path& directoryName)
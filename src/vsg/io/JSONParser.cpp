@@ -19,6 +19,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/read.h>
 
 #include <fstream>
+#include <locale>
+#include <sstream>
 
 using namespace vsg;
 
@@ -42,6 +44,12 @@ void JSONParser::Schema::read_number(JSONParser&, std::istream&)
 {
 }
 
+void JSONParser::Schema::read_number(JSONParser& parser, const std::string_view& value)
+{
+    parser.mstr.set(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+    read_number(parser, parser.mstr);
+}
+
 void JSONParser::Schema::read_bool(JSONParser&, bool)
 {
 }
@@ -66,6 +74,12 @@ void JSONParser::Schema::read_number(JSONParser&, const std::string_view&, std::
 {
 }
 
+void JSONParser::Schema::read_number(JSONParser& parser, const std::string_view& name, const std::string_view& value)
+{
+    parser.mstr.set(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+    read_number(parser, name, parser.mstr);
+}
+
 void JSONParser::Schema::read_bool(JSONParser&, const std::string_view&, bool)
 {
 }
@@ -119,10 +133,10 @@ void JSONtoMetaDataSchema::read_string(JSONParser& parser)
     addToArray(stringValue::create(value));
 }
 
-void JSONtoMetaDataSchema::read_number(JSONParser&, std::istream& input)
+void JSONtoMetaDataSchema::read_number(JSONParser& parser, const std::string_view& str)
 {
-    double value;
-    input >> value;
+    double value = 0.0;
+    if (!parser.parse_number(str, value)) parser.warning("JSONtoMetaDataSchema::read_number() could not parse ", str);
 
     addToArray(doubleValue::create(value));
 }
@@ -160,10 +174,10 @@ void JSONtoMetaDataSchema::read_string(JSONParser& parser, const std::string_vie
     addToObject(name, stringValue::create(value));
 }
 
-void JSONtoMetaDataSchema::read_number(JSONParser&, const std::string_view& name, std::istream& input)
+void JSONtoMetaDataSchema::read_number(JSONParser& parser, const std::string_view& name, const std::string_view& str)
 {
-    double value;
-    input >> value;
+    double value = 0.0;
+    if (!parser.parse_number(str, value)) parser.warning("JSONtoMetaDataSchema::read_number() could not parse ", str);
 
     addToObject(name, doubleValue::create(value));
 }
@@ -176,6 +190,55 @@ void JSONtoMetaDataSchema::read_bool(JSONParser&, const std::string_view& name,
 void JSONtoMetaDataSchema::read_null(JSONParser&, const std::string_view&)
 {
 }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// base64 decoding of data: URI's
+//
+namespace
+{
+    inline int8_t base64_value(char c)
+    {
+        if (c >= 'A' && c <= 'Z') return static_cast<int8_t>(c - 'A');
+        if (c >= 'a' && c <= 'z') return static_cast<int8_t>(c - 'a' + 26);
+        if (c >= '0' && c <= '9') return static_cast<int8_t>(c - '0' + 52);
+        if (c == '+' || c == '-') return 62;
+        if (c == '/' || c == '_') return 63;
+        return -1;
+    }
+
+    /// decode base64 encoded string directly into a ubyteArray, returns null if the string is not valid base64.
+    ref_ptr<ubyteArray> decode_base64(const std::string_view& str)
+    {
+        auto length = str.size();
+        while (length > 0 && str[length - 1] == '=') --length;
+        if ((length % 4) == 1) return {};
+
+        auto size = (length * 3) / 4;
+        if (size == 0) return {};
+
+        auto data = ubyteArray::create(static_cast<uint32_t>(size));
+        auto dest = data->data();
+
+        uint32_t accumulator = 0;
+        uint32_t bits = 0;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            auto v = base64_value(str[i]);
+            if (v < 0) return {};
+
+            accumulator = (accumulator << 6) | static_cast<uint32_t>(v);
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                *(dest++) = static_cast<uint8_t>((accumulator >> bits) & 0xff);
+            }
+        }
+
+        return data;
+    }
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // json parser
@@ -185,8 +248,72 @@ JSONParser::JSONParser() :
 {
 }
 
-bool JSONParser::read_uri(std::string& value, ref_ptr<Object>& object)
+bool JSONParser::parse_number(const std::string_view& str, double& value)
+{
+    const char* first = str.data();
+    const char* last = first + str.size();
+
+#if defined(__cpp_lib_to_chars)
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    return ec == std::errc() && ptr == last;
+#else
+    // floating point std::from_chars not supported by the standard library so fallback to a locale independent stream
+    std::istringstream input{std::string(first, last)};
+    input.imbue(std::locale::classic());
+    input >> value;
+    return !input.fail();
+#endif
+}
+
+std::size_t JSONParser::count_array_elements() const
+{
+    auto position = buffer.find_first_not_of(" \t\r\n", pos);
+    if (position == std::string::npos || buffer[position] != '[') return 0;
+
+    std::size_t count = 0;
+    bool element = false;
+    int depth = 0;
+    for (; position < buffer.size(); ++position)
+    {
+        char c = buffer[position];
+        if (c == '"')
+        {
+            // skip string, including escaped characters
+            for (++position; position < buffer.size() && buffer[position] != '"'; ++position)
+            {
+                if (buffer[position] == '\\') ++position;
+            }
+            element = true;
+        }
+        else if (c == '[' || c == '{')
+        {
+            if (depth > 0) element = true;
+            ++depth;
+        }
+        else if (c == ']' || c == '}')
+        {
+            if (--depth == 0) break;
+        }
+        else if (depth == 1 && c == ',')
+        {
+            if (element) ++count;
+            element = false;
+        }
+        else if (!white_space(c))
+        {
+            element = true;
+        }
+    }
+
+    if (element) ++count;
+    return count;
+}
+
+static bool read_uri(JSONParser& parser, std::string& value, ref_ptr<Object>& object, bool decodeBase64)
 {
+    auto& buffer = parser.buffer;
+    auto& pos = parser.pos;
+
     if (buffer[pos] != '"') return false;
 
     // read string
@@ -205,7 +332,16 @@ bool JSONParser::read_uri(std::string& value, ref_ptr<Object>& object)
             auto comma = buffer.find(',', semicolon + 1);
 
             value = memeType;
-            object = vsg::stringValue::create(buffer.substr(comma + 1, end_of_value - comma - 1));
+
+            // when requested decode base64 data directly from the buffer, falling back to the encoded string if it can't be decoded
+            std::string_view encoded(&buffer[comma + 1], end_of_value - comma - 1);
+            ref_ptr<ubyteArray> decoded;
+            if (decodeBase64 && buffer.compare(semicolon + 1, 7, "base64,") == 0) decoded = decode_base64(encoded);
+
+            if (decoded)
+                object = decoded;
+            else
+                object = vsg::stringValue::create(std::string(encoded));
 
             pos = end_of_value + 1;
 
@@ -215,13 +351,23 @@ bool JSONParser::read_uri(std::string& value, ref_ptr<Object>& object)
 
     value = buffer.substr(pos + 1, end_of_value - pos - 1);
 
-    object = vsg::read(value, options);
+    object = vsg::read(value, parser.options);
 
     pos = end_of_value + 1;
 
     return true;
 }
 
+bool JSONParser::read_uri(std::string& value, ref_ptr<Object>& object)
+{
+    return ::read_uri(*this, value, object, false);
+}
+
+bool JSONParser::read_uri_data(std::string& value, ref_ptr<Object>& object)
+{
+    return ::read_uri(*this, value, object, true);
+}
+
 bool JSONParser::read_string_view(std::string_view& value)
 {
     if (buffer[pos] != '"') return false;
@@ -419,8 +565,7 @@ void JSONParser::read_object(JSONParser::Schema& schema)
                 }
                 else
                 {
-                    mstr.set(reinterpret_cast<const uint8_t*>(&buffer.at(pos)), end_of_value - pos + 1);
-                    schema.read_number(*this, name, mstr);
+                    schema.read_number(*this, name, std::string_view(&buffer[pos], end_of_value - pos + 1));
                 }
 
                 // skip to end of field
@@ -513,9 +658,7 @@ void JSONParser::read_array(JSONParser::Schema& schema)
             }
             else
             {
-                mstr.set(reinterpret_cast<const uint8_t*>(&buffer.at(pos)), end_of_value - pos + 1);
-
-                schema.read_number(*this, mstr);
+                schema.read_number(*this, std::string_view(&buffer[pos], end_of_value - pos + 1));
             }
 
             // skip to end of field
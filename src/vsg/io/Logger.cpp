@@ -113,71 +113,64 @@ void Logger::debug_stream(PrintToStreamFunction print)
 {
     if (level > LOGGER_DEBUG) return;
 
-    std::scoped_lock<std::mutex> lock(_mutex);
-    _stream.str({});
-    _stream.clear();
-
-    print(_stream);
+    auto& stream = _threadStream();
+    print(stream);
 
-    debug_implementation(_stream.str());
+    _dispatch(LOGGER_DEBUG, stream.str());
 }
 
 void Logger::info_stream(PrintToStreamFunction print)
 {
     if (level > LOGGER_INFO) return;
 
-    std::scoped_lock<std::mutex> lock(_mutex);
-    _stream.str({});
-    _stream.clear();
-
-    print(_stream);
+    auto& stream = _threadStream();
+    print(stream);
 
-    info_implementation(_stream.str());
+    _dispatch(LOGGER_INFO, stream.str());
 }
 
 void Logger::warn_stream(PrintToStreamFunction print)
 {
     if (level > LOGGER_WARN) return;
 
-    std::scoped_lock<std::mutex> lock(_mutex);
-    _stream.str({});
-    _stream.clear();
-
-    print(_stream);
+    auto& stream = _threadStream();
+    print(stream);
 
-    warn_implementation(_stream.str());
+    _dispatch(LOGGER_WARN, stream.str());
 }
 
 void Logger::error_stream(PrintToStreamFunction print)
 {
     if (level > LOGGER_ERROR) return;
 
-    std::scoped_lock<std::mutex> lock(_mutex);
-    _stream.str({});
-    _stream.clear();
+    auto& stream = _threadStream();
+    print(stream);
 
-    print(_stream);
-
-    error_implementation(_stream.str());
+    _dispatch(LOGGER_ERROR, stream.str());
 }
 
 void Logger::fatal_stream(PrintToStreamFunction print)
 {
     if (level > LOGGER_FATAL) return;
 
-    std::scoped_lock<std::mutex> lock(_mutex);
-    _stream.str({});
-    _stream.clear();
+    auto& stream = _threadStream();
+    print(stream);
 
-    print(_stream);
+    _dispatch(LOGGER_FATAL, stream.str());
+}
 
-    fatal_implementation(_stream.str());
+std::ostringstream& Logger::_threadStream()
+{
+    thread_local std::ostringstream s_stream;
+    s_stream.str({});
+    s_stream.clear();
+    return s_stream;
 }
 
-void Logger::log(Level msg_level, const std::string_view& message)
+void Logger::_dispatch(Level msg_level, const std::string_view& message)
 {
-    if (level > msg_level) return;
-    std::scoped_lock<std::mutex> lock(_mutex);
+    std::unique_lock<std::mutex> lock(_mutex, std::defer_lock);
+    if (!_threadSafeImplementation) lock.lock();
 
     switch (msg_level)
     {
@@ -190,25 +183,21 @@ void Logger::log(Level msg_level, const std::string_view& message)
     }
 }
 
-void Logger::log_stream(Level msg_level, PrintToStreamFunction print)
+void Logger::log(Level msg_level, const std::string_view& message)
 {
     if (level > msg_level) return;
 
-    std::scoped_lock<std::mutex> lock(_mutex);
-    _stream.str({});
-    _stream.clear();
+    _dispatch(msg_level, message);
+}
 
-    print(_stream);
+void Logger::log_stream(Level msg_level, PrintToStreamFunction print)
+{
+    if (level > msg_level) return;
 
-    switch (msg_level)
-    {
-    case (LOGGER_DEBUG): debug_implementation(_stream.str()); break;
-    case (LOGGER_INFO): info_implementation(_stream.str()); break;
-    case (LOGGER_WARN): warn_implementation(_stream.str()); break;
-    case (LOGGER_ERROR): error_implementation(_stream.str()); break;
-    case (LOGGER_FATAL): fatal_implementation(_stream.str()); break;
-    default: break;
-    }
+    auto& stream = _threadStream();
+    print(stream);
+
+    _dispatch(msg_level, stream.str());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -279,11 +268,10 @@ void ThreadLogger::print_id(FILE* out, std::thread::id id)
     }
     else
     {
-        // no name string for this thread yet, so create one using the Logger::_stream and then assign to _threadPrefixes for future use
-        _stream.str({});
-        _stream.clear();
-        _stream << "thread::id = " << id << " | ";
-        const auto& str = _threadPrefixes[id] = _stream.str();
+        // no name string for this thread yet, so create one and assign to _threadPrefixes for future use
+        std::ostringstream stream;
+        stream << "thread::id = " << id << " | ";
+        const auto& str = _threadPrefixes[id] = stream.str();
         fprintf(out, "%s", str.c_str());
     }
 }
@@ -178,6 +178,8 @@ ObjectFactory::ObjectFactory()
     add<vsg::StateGroup>();
     add<vsg::CullGroup>();
     add<vsg::CullNode>();
+    add<vsg::BatchCullGroup>();
+    add<vsg::Occluder>();
     add<vsg::LOD>();
     add<vsg::PagedLOD>();
     add<vsg::AbsoluteTransform>();
@@ -196,6 +198,7 @@ ObjectFactory::ObjectFactory()
     add<vsg::InstanceNode>();
     add<vsg::InstanceDraw>();
     add<vsg::InstanceDrawIndexed>();
+    add<vsg::InstanceCulling>();
 
     // lighting
     add<vsg::Light>();
@@ -314,6 +317,7 @@ ObjectFactory::ObjectFactory()
     add<vsg::MorphKeyframes>();
     add<vsg::MorphSampler>();
     add<vsg::JointSampler>();
+    add<vsg::ComputeSkinning>();
     add<vsg::Animation>();
     add<vsg::AnimationGroup>();
     add<vsg::Joint>();
@@ -10,6 +10,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/MappedData.h>
 #include <vsg/core/Version.h>
 #include <vsg/io/AsciiInput.h>
 #include <vsg/io/AsciiOutput.h>
@@ -17,6 +18,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/BinaryOutput.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/VSG.h>
+#include <vsg/io/compression.h>
 #include <vsg/io/mem_stream.h>
 
 using namespace vsg;
@@ -50,6 +52,23 @@ VSG::VSG() :
 
 VSG::FormatInfo VSG::readHeader(std::istream& fin) const
 {
+    BinarySettings settings;
+    return readHeader(fin, settings);
+}
+
+VSG::FormatInfo VSG::readHeader(std::istream& fin, uint32_t& alignmentValue, uint32_t& alignmentThreshold) const
+{
+    BinarySettings settings;
+    auto formatInfo = readHeader(fin, settings);
+    alignmentValue = settings.alignment;
+    alignmentThreshold = settings.alignmentThreshold;
+    return formatInfo;
+}
+
+VSG::FormatInfo VSG::readHeader(std::istream& fin, BinarySettings& settings) const
+{
+    settings = {};
+
     fin.imbue(s_class_locale);
 
     const char* match_token_ascii = "#vsga";
@@ -74,10 +93,42 @@ VSG::FormatInfo VSG::readHeader(std::istream& fin) const
 
     auto version = parseVersion(version_string);
 
+    // optional class name table flag follows the version, i.e. "#vsgb 1.1.14 classtable"
+    settings.classTable = (version_string.find("classtable") != std::string::npos);
+
+    // optional chunk settings follow the version, i.e. "#vsgb 1.1.14 chunked 65536"
+    if (auto pos = version_string.find("chunked"); pos != std::string::npos)
+    {
+        std::stringstream str(version_string.substr(pos + 7));
+        str >> settings.chunkThreshold;
+        if (!str) settings.chunkThreshold = 0;
+    }
+
+    // optional alignment settings follow the version, i.e. "#vsgb 1.1.14 alignment 64 1024"
+    if (auto pos = version_string.find("alignment"); pos != std::string::npos)
+    {
+        std::stringstream str(version_string.substr(pos + 9));
+        str >> settings.alignment >> settings.alignmentThreshold;
+        if (!str) settings.alignment = settings.alignmentThreshold = 0;
+    }
+
     return FormatInfo(type, version);
 }
 
 void VSG::writeHeader(std::ostream& fout, const FormatInfo& formatInfo) const
+{
+    writeHeader(fout, formatInfo, BinarySettings{});
+}
+
+void VSG::writeHeader(std::ostream& fout, const FormatInfo& formatInfo, uint32_t alignmentValue, uint32_t alignmentThreshold) const
+{
+    BinarySettings settings;
+    settings.alignment = alignmentValue;
+    settings.alignmentThreshold = alignmentThreshold;
+    writeHeader(fout, formatInfo, settings);
+}
+
+void VSG::writeHeader(std::ostream& fout, const FormatInfo& formatInfo, const BinarySettings& settings) const
 {
     if (formatInfo.first == NOT_RECOGNIZED) return;
 
@@ -88,7 +139,60 @@ void VSG::writeHeader(std::ostream& fout, const FormatInfo& formatInfo) const
         fout << "#vsga";
 
     auto version = formatInfo.second;
-    fout << " " << version.major << "." << version.minor << "." << version.patch << "\n";
+    fout << " " << version.major << "." << version.minor << "." << version.patch;
+    if (settings.classTable) fout << " classtable";
+    if (settings.chunkThreshold != 0) fout << " chunked " << settings.chunkThreshold;
+    if (settings.alignment != 0) fout << " alignment " << settings.alignment << " " << settings.alignmentThreshold;
+    fout << "\n";
+}
+
+void VSG::assignSettings(BinaryInput& input, const BinarySettings& settings, const Options* options) const
+{
+    input.alignment = settings.alignment;
+    input.alignmentThreshold = settings.alignmentThreshold;
+    input.classTable = settings.classTable;
+    input.chunkThreshold = settings.chunkThreshold;
+
+    // decompress all the chunks up front in parallel when threads are available, otherwise chunks are decompressed as they are read
+    if (input.chunkThreshold != 0 && options && options->operationThreads)
+    {
+        input.decompressChunks(options->operationThreads);
+    }
+}
+
+VSG::BinarySettings VSG::assignSettings(BinaryOutput& output, const Options* options) const
+{
+    if (options)
+    {
+        options->getValue(VSG::alignment, output.alignment);
+        options->getValue(VSG::class_table, output.classTable);
+        options->getValue(VSG::chunk_threshold, output.chunkThreshold);
+
+        std::string compression;
+        if (options->getValue(VSG::compression, compression))
+        {
+            if (compression == "zstd")
+                output.compressionCodec = COMPRESSION_ZSTD;
+            else if (compression != "none")
+                warn("VSG::write() unsupported compression \"", compression, "\"");
+
+            if (!compressionSupported(output.compressionCodec))
+            {
+                warn("VSG::write() compression \"", compression, "\" not supported by this build, writing chunks uncompressed.");
+                output.compressionCodec = COMPRESSION_NONE;
+            }
+
+            // compression is applied per chunk so enable chunking if not already set
+            if (output.compressionCodec != COMPRESSION_NONE && output.chunkThreshold == 0) output.chunkThreshold = 65536;
+        }
+    }
+
+    BinarySettings settings;
+    settings.alignment = output.alignment;
+    settings.alignmentThreshold = output.alignmentThreshold;
+    settings.classTable = output.classTable;
+    settings.chunkThreshold = output.chunkThreshold;
+    return settings;
 }
 
 vsg::ref_ptr<vsg::Object> VSG::read(const vsg::Path& filename, ref_ptr<const Options> options) const
@@ -100,15 +204,39 @@ vsg::ref_ptr<vsg::Object> VSG::read(const vsg::Path& filename, ref_ptr<const Opt
     vsg::Path filenameToUse = findFile(filename, options);
     if (!filenameToUse) return {};
 
+    bool memoryMap = false;
+    if (options) options->getValue(VSG::memory_map, memoryMap);
+
+    if (memoryMap && lowerCaseFileExtension(filenameToUse) == ".vsgb")
+    {
+        auto mappedData = MappedData::create(filenameToUse);
+        if (!mappedData->dataAvailable()) return {};
+
+        mem_stream fin(static_cast<const uint8_t*>(mappedData->dataPointer()), mappedData->dataSize());
+
+        BinarySettings settings;
+        if (auto [type, version] = readHeader(fin, settings); type == BINARY)
+        {
+            vsg::BinaryInput input(fin, _objectFactory, options);
+            input.filename = filenameToUse;
+            input.version = version;
+            input.mappedData = mappedData;
+            assignSettings(input, settings, options);
+            return input.readObject("Root");
+        }
+    }
+
     std::ifstream fin(filenameToUse, std::ios::in | std::ios::binary);
     if (!fin) return {};
 
-    auto [type, version] = readHeader(fin);
+    BinarySettings settings;
+    auto [type, version] = readHeader(fin, settings);
     if (type == BINARY)
     {
         vsg::BinaryInput input(fin, _objectFactory, options);
         input.filename = filenameToUse;
         input.version = version;
+        assignSettings(input, settings, options);
         return input.readObject("Root");
     }
     else if (type == ASCII)
@@ -129,11 +257,16 @@ vsg::ref_ptr<vsg::Object> VSG::read(std::istream& fin, vsg::ref_ptr<const vsg::O
 
     if (options && !compatibleExtension(options, ".vsgb", ".vsgt")) return {};
 
-    auto [type, version] = readHeader(fin);
+    auto origin = fin.tellg();
+
+    BinarySettings settings;
+    auto [type, version] = readHeader(fin, settings);
     if (type == BINARY)
     {
         vsg::BinaryInput input(fin, _objectFactory, options);
         input.version = version;
+        input.alignmentOrigin = origin;
+        assignSettings(input, settings, options);
         return input.readObject("Root");
     }
     else if (type == ASCII)
@@ -175,11 +308,15 @@ bool VSG::write(const vsg::Object* object, const vsg::Path& filename, ref_ptr<co
     if (ext == ".vsgb")
     {
         std::ofstream fout(filename, std::ios::out | std::ios::binary);
-        writeHeader(fout, FormatInfo{BINARY, version});
 
         vsg::BinaryOutput output(fout, options);
+        auto settings = assignSettings(output, options);
+
+        writeHeader(fout, FormatInfo{BINARY, version}, settings);
+
         output.version = version;
         output.writeObject("Root", object);
+        output.writeChunkIndex();
         return true;
     }
     else if (ext == ".vsga" || ext == ".vsgt")
@@ -229,11 +366,15 @@ bool VSG::write(const vsg::Object* object, std::ostream& fout, ref_ptr<const Opt
     }
     else
     {
-        writeHeader(fout, FormatInfo(BINARY, version));
-
         vsg::BinaryOutput output(fout, options);
+        auto settings = assignSettings(output, options);
+        output.alignmentOrigin = fout.tellp();
+
+        writeHeader(fout, FormatInfo(BINARY, version), settings);
+
         output.version = version;
         output.writeObject("Root", object);
+        output.writeChunkIndex();
         return true;
     }
 }
@@ -242,5 +383,10 @@ bool VSG::getFeatures(Features& features) const
 {
     features.extensionFeatureMap[".vsgb"] = static_cast<FeatureMask>(READ_FILENAME | READ_ISTREAM | READ_MEMORY | WRITE_FILENAME | WRITE_OSTREAM);
     features.extensionFeatureMap[".vsgt"] = static_cast<FeatureMask>(READ_FILENAME | READ_ISTREAM | READ_MEMORY | WRITE_FILENAME | WRITE_OSTREAM);
+    features.optionNameTypeMap[VSG::memory_map] = type_name<bool>();
+    features.optionNameTypeMap[VSG::alignment] = type_name<uint32_t>();
+    features.optionNameTypeMap[VSG::class_table] = type_name<bool>();
+    features.optionNameTypeMap[VSG::chunk_threshold] = type_name<uint32_t>();
+    features.optionNameTypeMap[VSG::compression] = type_name<std::string>();
     return true;
 }
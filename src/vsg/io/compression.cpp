@@ -0,0 +1,79 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Version.h>
+#include <vsg/io/compression.h>
+
+#include <cstring>
+
+#if VSG_SUPPORTS_zstd
+#    include <zstd.h>
+#endif
+
+using namespace vsg;
+
+bool vsg::compressionSupported(CompressionCodec codec)
+{
+    switch (codec)
+    {
+    case COMPRESSION_NONE:
+        return true;
+    case COMPRESSION_ZSTD:
+        return VSG_SUPPORTS_zstd == 1;
+    default:
+        return false;
+    }
+}
+
+bool vsg::compress(CompressionCodec codec, const void* src, size_t size, std::vector<uint8_t>& dest, int level)
+{
+    switch (codec)
+    {
+    case COMPRESSION_NONE:
+        dest.resize(size);
+        if (size > 0) std::memcpy(dest.data(), src, size);
+        return true;
+#if VSG_SUPPORTS_zstd
+    case COMPRESSION_ZSTD:
+    {
+        dest.resize(ZSTD_compressBound(size));
+        size_t compressedSize = ZSTD_compress(dest.data(), dest.size(), src, size, level);
+        if (ZSTD_isError(compressedSize)) return false;
+        dest.resize(compressedSize);
+        return true;
+    }
+#endif
+    default:
+        (void)level;
+        return false;
+    }
+}
+
+bool vsg::decompress(CompressionCodec codec, const void* src, size_t compressedSize, void* dest, size_t size)
+{
+    switch (codec)
+    {
+    case COMPRESSION_NONE:
+        if (compressedSize != size) return false;
+        if (size > 0) std::memcpy(dest, src, size);
+        return true;
+#if VSG_SUPPORTS_zstd
+    case COMPRESSION_ZSTD:
+    {
+        size_t decompressedSize = ZSTD_decompress(dest, size, src, compressedSize);
+        return !ZSTD_isError(decompressedSize) && decompressedSize == size;
+    }
+#endif
+    default:
+        return false;
+    }
+}
@@ -83,17 +83,35 @@ ref_ptr<Object> vsg::read(const Path& filename, ref_ptr<const Options> options)
             if (load->object && options && options->findDynamicObjects && options->propagateDynamicObjects)
             {
                 // invoke the find and propagate visitors to collate all the dynamic objects that will need to be cloned.
-
-                std::scoped_lock<std::mutex> fdo_lock(options->findDynamicObjects->mutex);
-
-                options->findDynamicObjects->dynamicObjects.clear();
-                load->object->accept(*(options->findDynamicObjects));
-
-                std::scoped_lock<std::mutex> pdo_lock(options->propagateDynamicObjects->mutex);
-                options->propagateDynamicObjects->dynamicObjects.swap(options->findDynamicObjects->dynamicObjects);
-                load->object->accept(*(options->propagateDynamicObjects));
-
-                load->dynamicObjects.swap(options->propagateDynamicObjects->dynamicObjects);
+                auto collate = [&](FindDynamicObjects& findDynamicObjects, PropagateDynamicObjects& propagateDynamicObjects) {
+                    findDynamicObjects.dynamicObjects.clear();
+                    load->object->accept(findDynamicObjects);
+
+                    // nothing dynamic found so no need to propagate classification to parents
+                    if (findDynamicObjects.dynamicObjects.empty()) return;
+
+                    propagateDynamicObjects.dynamicObjects.swap(findDynamicObjects.dynamicObjects);
+                    load->object->accept(propagateDynamicObjects);
+
+                    load->dynamicObjects.swap(propagateDynamicObjects.dynamicObjects);
+                };
+
+                auto& fdo = *(options->findDynamicObjects);
+                auto& pdo = *(options->propagateDynamicObjects);
+                if (typeid(fdo) == typeid(FindDynamicObjects) && typeid(pdo) == typeid(PropagateDynamicObjects))
+                {
+                    // the default visitors have no settings, so use local instances to avoid concurrent reads sharing the same Options serializing on their mutexes
+                    FindDynamicObjects findDynamicObjects;
+                    PropagateDynamicObjects propagateDynamicObjects;
+                    collate(findDynamicObjects, propagateDynamicObjects);
+                }
+                else
+                {
+                    // application supplied visitors, use them directly
+                    std::scoped_lock<std::mutex> fdo_lock(fdo.mutex);
+                    std::scoped_lock<std::mutex> pdo_lock(pdo.mutex);
+                    collate(fdo, pdo);
+                }
             }
         });
 
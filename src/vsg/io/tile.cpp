@@ -29,6 +29,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/DescriptorImage.h>
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/state/material.h>
+#include <vsg/threading/Latch.h>
 #include <vsg/ui/UIEvent.h>
 #include <vsg/utils/ComputeBounds.h>
 #include <vsg/utils/CoordinateSpace.h>
@@ -115,6 +116,144 @@ vsg::Path tile::getTilePath(const vsg::Path& src, uint32_t x, uint32_t y, uint32
     return path;
 }
 
+void tile::addLayerReads(std::vector<LayerRead>& layerReads, uint32_t x, uint32_t y, uint32_t lod) const
+{
+    if (settings->imageLayer) layerReads.push_back(LayerRead{getTilePath(settings->imageLayer, x, y, lod), 0, x, y, {}, 0.0});
+    if (settings->detailLayer) layerReads.push_back(LayerRead{getTilePath(settings->detailLayer, x, y, lod), 1, x, y, {}, 0.0});
+    if (settings->elevationLayer) layerReads.push_back(LayerRead{getTilePath(settings->elevationLayer, x, y, lod), 2, x, y, {}, 0.0});
+}
+
+void tile::readLayers(std::vector<LayerRead>& layerReads, ref_ptr<const Options> options) const
+{
+    CPU_INSTRUMENTATION_L2_NC(options ? options->instrumentation.get() : nullptr, "tile readLayers", COLOR_READ);
+
+    struct ReadLayerOperation : public Operation
+    {
+        ReadLayerOperation(LayerRead& lr, ref_ptr<const Options> opt, ref_ptr<Latch> l) :
+            layerRead(lr),
+            options(opt),
+            latch(l) {}
+
+        void run() override
+        {
+            vsg::time_point start_read = vsg::clock::now();
+            layerRead.data = vsg::read_cast<vsg::Data>(layerRead.path, options);
+            layerRead.time = std::chrono::duration<double, std::chrono::milliseconds::period>(vsg::clock::now() - start_read).count();
+
+            if (latch) latch->count_down();
+        }
+
+        LayerRead& layerRead;
+        ref_ptr<const Options> options;
+        ref_ptr<Latch> latch;
+    };
+
+    ref_ptr<OperationThreads> operationThreads;
+    if (options) operationThreads = options->operationThreads;
+    if (!operationThreads && numReadThreads > 0 && layerReads.size() > 1)
+    {
+        std::scoped_lock<std::mutex> lock(_operationThreadsMutex);
+        if (!_operationThreads) _operationThreads = OperationThreads::create(numReadThreads);
+        operationThreads = _operationThreads;
+    }
+
+    if (operationThreads && layerReads.size() > 1)
+    {
+        // use latch to synchronize this thread with the layer reading threads
+        auto latch = Latch::create(static_cast<int>(layerReads.size()));
+
+        for (auto& layerRead : layerReads)
+        {
+            operationThreads->add(ref_ptr<Operation>(new ReadLayerOperation(layerRead, options, latch)));
+        }
+
+        // use this thread to read the layers as well
+        operationThreads->run();
+
+        // wait till all the layer reads have completed
+        latch->wait();
+    }
+    else
+    {
+        for (auto& layerRead : layerReads)
+        {
+            ReadLayerOperation(layerRead, options, {}).run();
+        }
+    }
+
+    std::scoped_lock<std::mutex> lock(statsMutex);
+    for (auto& layerRead : layerReads)
+    {
+        numLayersRead[layerRead.type] += 1;
+        totalTimeReadingLayers[layerRead.type] += layerRead.time;
+    }
+}
+
+ref_ptr<VertexIndexDraw> tile::getCachedGeometry(const GeometryKey& key) const
+{
+    ref_ptr<VertexIndexDraw> vid;
+    {
+        std::scoped_lock<std::mutex> lock(_geometryMapMutex);
+        if (auto itr = _geometryMap.find(key); itr != _geometryMap.end())
+        {
+            // move to the front of the LRU list as it's now the most recently used
+            _geometryLRU.splice(_geometryLRU.begin(), _geometryLRU, itr->second);
+            vid = itr->second->vid;
+        }
+    }
+
+    std::scoped_lock<std::mutex> lock(statsMutex);
+    if (vid)
+        ++numGeometryCacheHits;
+    else
+        ++numGeometryCacheMisses;
+
+    return vid;
+}
+
+void tile::addCachedGeometry(const GeometryKey& key, ref_ptr<VertexIndexDraw> vid) const
+{
+    if (geometryCacheMaxMemory == 0 || !vid) return;
+
+    size_t size = 0;
+    if (vid->indices && vid->indices->data) size += vid->indices->data->dataSize();
+    for (auto& array : vid->arrays)
+    {
+        if (array && array->data) size += array->data->dataSize();
+    }
+
+    // don't cache meshes that could never fit in the budget
+    if (size > geometryCacheMaxMemory) return;
+
+    uint64_t numEvicted = 0;
+    size_t cacheMemory = 0;
+    {
+        std::scoped_lock<std::mutex> lock(_geometryMapMutex);
+
+        // another thread may have already added an equivalent mesh
+        if (_geometryMap.count(key) != 0) return;
+
+        // evict least recently used meshes till the new mesh fits, meshes already in the scene graph are unaffected.
+        while (!_geometryLRU.empty() && (_geometryCacheMemory + size) > geometryCacheMaxMemory)
+        {
+            auto& entry = _geometryLRU.back();
+            _geometryCacheMemory -= entry.size;
+            _geometryMap.erase(entry.key);
+            _geometryLRU.pop_back();
+            ++numEvicted;
+        }
+
+        _geometryLRU.push_front(GeometryEntry{key, vid, size});
+        _geometryMap[key] = _geometryLRU.begin();
+        _geometryCacheMemory += size;
+        cacheMemory = _geometryCacheMemory;
+    }
+
+    std::scoped_lock<std::mutex> lock(statsMutex);
+    numGeometryCacheEvictions += numEvicted;
+    geometryCacheMemory = cacheMemory;
+}
+
 vsg::ref_ptr<vsg::Object> tile::read(const vsg::Path& filename, vsg::ref_ptr<const vsg::Options> options) const
 {
     CPU_INSTRUMENTATION_L1_NC(options ? options->instrumentation.get() : nullptr, "tile read", COLOR_READ);
@@ -149,51 +288,43 @@ vsg::ref_ptr<vsg::Object> tile::read_root(vsg::ref_ptr<const vsg::Options> optio
     auto group = createRoot();
 
     uint32_t lod = 0;
+
+    // read all the layers of the root tiles concurrently
+    std::vector<LayerRead> layerReads;
     for (uint32_t y = 0; y < settings->noY; ++y)
     {
         for (uint32_t x = 0; x < settings->noX; ++x)
         {
-            ref_ptr<Data> imageData, detailData, elevationData;
+            addLayerReads(layerReads, x, y, lod);
+        }
+    }
 
-            if (settings->imageLayer)
-            {
-                auto imagePath = getTilePath(settings->imageLayer, x, y, lod);
-                imageData = vsg::read_cast<vsg::Data>(imagePath, options);
-                if (imageData && settings->imageLayerCallback)
-                {
-                    imageData = settings->imageLayerCallback(imageData);
-                }
-                else if (!imageData)
-                {
-                    vsg::warn("tile::read_root() unable read image data, imagePath = ", imagePath);
-                }
-            }
+    readLayers(layerReads, options);
+
+    auto layerRead = layerReads.begin();
+    for (uint32_t y = 0; y < settings->noY; ++y)
+    {
+        for (uint32_t x = 0; x < settings->noX; ++x)
+        {
+            ref_ptr<Data> imageData, detailData, elevationData;
 
-            if (settings->detailLayer)
+            for (; layerRead != layerReads.end() && layerRead->local_x == x && layerRead->local_y == y; ++layerRead)
             {
-                auto detailPath = getTilePath(settings->detailLayer, x, y, lod);
-                detailData = vsg::read_cast<vsg::Data>(detailPath, options);
-                if (detailData && settings->detailLayerCallback)
+                auto& data = layerRead->data;
+                if (layerRead->type == 0)
                 {
-                    detailData = settings->detailLayerCallback(detailData);
+                    if (data) imageData = (settings->imageLayerCallback) ? settings->imageLayerCallback(data) : data;
+                    else vsg::warn("tile::read_root() unable read image data, imagePath = ", layerRead->path);
                 }
-                else if (!detailData)
+                else if (layerRead->type == 1)
                 {
-                    vsg::warn("tile::read_root() unable read detail data, detailPath = ", detailPath);
+                    if (data) detailData = (settings->detailLayerCallback) ? settings->detailLayerCallback(data) : data;
+                    else vsg::warn("tile::read_root() unable read detail data, detailPath = ", layerRead->path);
                 }
-            }
-
-            if (settings->elevationLayer)
-            {
-                auto terrainPath = getTilePath(settings->elevationLayer, x, y, lod);
-                elevationData = vsg::read_cast<vsg::Data>(terrainPath, options);
-                if (elevationData && settings->elevationLayerCallback)
+                else if (layerRead->type == 2)
                 {
-                    elevationData = settings->elevationLayerCallback(elevationData);
-                }
-                else if (!elevationData)
-                {
-                    vsg::warn("tile::read_root() unable read elevation data, terrainPath = ", terrainPath);
+                    if (data) elevationData = (settings->elevationLayerCallback) ? settings->elevationLayerCallback(data) : data;
+                    else vsg::warn("tile::read_root() unable read elevation data, terrainPath = ", layerRead->path);
                 }
             }
 
@@ -280,57 +411,30 @@ vsg::ref_ptr<vsg::Object> tile::read_subtile(uint32_t x, uint32_t y, uint32_t lo
     {
         uint32_t local_x;
         uint32_t local_y;
-        uint32_t type; // type = 0 -> imageData, 1 -> detailLayer, 2 -> elevationLayer
 
         bool operator<(const TileID& rhs) const
         {
             if (local_x < rhs.local_x) return true;
             if (local_x > rhs.local_x) return false;
-
-            if (local_y < rhs.local_y) return true;
-            if (local_y > rhs.local_y) return false;
-
-            return type < rhs.type;
+            return local_y < rhs.local_y;
         }
     };
 
-    vsg::Paths tiles;
-    std::map<vsg::Path, TileID> pathToTileID;
-
     uint32_t subtile_x = x * 2;
     uint32_t subtile_y = y * 2;
     uint32_t local_lod = lod + 1;
+
+    // read the image, detail and elevation layers of all 4 subtiles concurrently
+    std::vector<LayerRead> layerReads;
     for (uint32_t dy = 0; dy < 2; ++dy)
     {
         for (uint32_t dx = 0; dx < 2; ++dx)
         {
-            uint32_t local_x = subtile_x + dx;
-            uint32_t local_y = subtile_y + dy;
-
-            if (settings->imageLayer)
-            {
-                auto tilePath = getTilePath(settings->imageLayer, local_x, local_y, local_lod);
-                tiles.push_back(tilePath);
-                pathToTileID[tilePath] = TileID{local_x, local_y, 0};
-            }
-
-            if (settings->detailLayer)
-            {
-                auto tilePath = getTilePath(settings->detailLayer, local_x, local_y, local_lod);
-                tiles.push_back(tilePath);
-                pathToTileID[tilePath] = TileID{local_x, local_y, 1};
-            }
-
-            if (settings->elevationLayer)
-            {
-                auto tilePath = getTilePath(settings->elevationLayer, local_x, local_y, local_lod);
-                tiles.push_back(tilePath);
-                pathToTileID[tilePath] = TileID{local_x, local_y, 2};
-            }
+            addLayerReads(layerReads, subtile_x + dx, subtile_y + dy, local_lod);
         }
     }
 
-    auto pathObjects = vsg::read(tiles, options);
+    readLayers(layerReads, options);
 
     struct TileData
     {
@@ -339,24 +443,23 @@ vsg::ref_ptr<vsg::Object> tile::read_subtile(uint32_t x, uint32_t y, uint32_t lo
         ref_ptr<Data> elevationData;
     };
 
-    // map the read files back to their TileID
+    // map the read layers back to their TileID
     std::map<TileID, TileData> tileData;
-    for (auto& [tilePath, object] : pathObjects)
+    for (auto& layerRead : layerReads)
     {
-        if (auto data = object.cast<Data>())
+        if (auto data = layerRead.data)
         {
-            auto tileID = pathToTileID[tilePath];
-            auto& entry = tileData[TileID{tileID.local_x, tileID.local_y, 0}];
+            auto& entry = tileData[TileID{layerRead.local_x, layerRead.local_y}];
 
-            if (tileID.type == 0)
+            if (layerRead.type == 0)
             {
                 entry.imageData = (settings->imageLayerCallback) ? settings->imageLayerCallback(data) : data;
             }
-            else if (tileID.type == 1)
+            else if (layerRead.type == 1)
             {
                 entry.detailData = (settings->detailLayerCallback) ? settings->detailLayerCallback(data) : data;
             }
-            else if (tileID.type == 2)
+            else if (layerRead.type == 2)
             {
                 entry.elevationData = (settings->elevationLayerCallback) ? settings->elevationLayerCallback(data) : data;
             }
@@ -657,17 +760,17 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
         numTriangles += 4 * (numCols + numRows - 2);
     }
 
-    dvec4 geometryKey{tile_extents.min.y, (tile_extents.max.y - tile_extents.min.y), static_cast<double>(numRows), static_cast<double>(numCols)};
-    ref_ptr<VertexIndexDraw> vid;
+    GeometryKey geometryKey;
+    geometryKey.latitudeMin = tile_extents.min.y;
+    geometryKey.latitudeRange = tile_extents.max.y - tile_extents.min.y;
+    geometryKey.longitudeRange = tile_extents.max.x - tile_extents.min.x;
+    geometryKey.numRows = numRows;
+    geometryKey.numCols = numCols;
+    geometryKey.skirtRatio = settings->skirtRatio;
+    if (elevationData) geometryKey.displacementMapScale = vec4(displacementMapScale.x, displacementMapScale.y, displacementMapScale.z, 1.0f);
 
     // check if reusable geometry exists already
-    {
-        std::scoped_lock<std::mutex> lock(_geometryMapMutex);
-        if (auto itr = _geometryMap.find(geometryKey); itr != _geometryMap.end())
-        {
-            vid = itr->second;
-        }
-    };
+    auto vid = getCachedGeometry(geometryKey);
 
     // if no usable geometry exist create one
     if (!vid)
@@ -842,10 +945,7 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
         vid->indexCount = static_cast<uint32_t>(indices->size());
         vid->instanceCount = 1;
 
-        {
-            std::scoped_lock<std::mutex> lock(_geometryMapMutex);
-            _geometryMap[geometryKey] = vid;
-        }
+        addCachedGeometry(geometryKey, vid);
     }
 
     transform->addChild(vid);
@@ -0,0 +1,290 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/stream.h>
+#include <vsg/nodes/BatchCullGroup.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define VSG_BATCH_CULL_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define VSG_BATCH_CULL_NEON 1
+#endif
+
+using namespace vsg;
+
+namespace
+{
+    constexpr size_t maxNumPlanes = 8;
+    constexpr float paddingRadius = -std::numeric_limits<float>::max();
+    constexpr float unboundedRadius = std::numeric_limits<float>::max();
+
+    // bound on the relative rounding error of the float plane tests, covering the conversion of the centers, radii and planes to float and the float arithmetic
+    constexpr double errorScale = 8.0 * std::numeric_limits<float>::epsilon();
+} // namespace
+
+BatchCullGroup::BatchCullGroup()
+{
+}
+
+BatchCullGroup::BatchCullGroup(const BatchCullGroup& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    bound(rhs.bound),
+    _unbounded(rhs._unbounded),
+    _origin(rhs._origin),
+    _x(rhs._x),
+    _y(rhs._y),
+    _z(rhs._z),
+    _radius(rhs._radius)
+{
+    children.reserve(rhs.children.size());
+    for (auto& child : rhs.children)
+    {
+        children.push_back(Child{child.bound, copyop(child.node)});
+    }
+}
+
+BatchCullGroup::~BatchCullGroup()
+{
+}
+
+int BatchCullGroup::compare(const Object& rhs_object) const
+{
+    int result = Object::compare(rhs_object);
+    if (result != 0) return result;
+
+    auto& rhs = static_cast<decltype(*this)>(rhs_object);
+
+    if ((result = compare_value(bound, rhs.bound)) != 0) return result;
+
+    // compare the children vector
+    if (children.size() < rhs.children.size()) return -1;
+    if (children.size() > rhs.children.size()) return 1;
+    if (children.empty()) return 0;
+
+    auto rhs_itr = rhs.children.begin();
+    for (auto lhs_itr = children.begin(); lhs_itr != children.end(); ++lhs_itr, ++rhs_itr)
+    {
+        if ((result = compare_value(lhs_itr->bound, rhs_itr->bound)) != 0) return result;
+        if ((result = compare_pointer(lhs_itr->node, rhs_itr->node)) != 0) return result;
+    }
+    return 0;
+}
+
+void BatchCullGroup::addChild(const dsphere& childBound, ref_ptr<Node> child)
+{
+    children.push_back(Child{childBound, child});
+
+    if (children.size() == 1) _origin = childBound.center;
+
+    _expandBound(childBound);
+    _appendBound(children.size() - 1, childBound);
+}
+
+void BatchCullGroup::dirty()
+{
+    bound.reset();
+    _unbounded = false;
+
+    // size the arrays to whole blocks of 4, with padding entries that always fail the intersection test
+    size_t size = ((children.size() + 3) / 4) * 4;
+    _x.assign(size, 0.0f);
+    _y.assign(size, 0.0f);
+    _z.assign(size, 0.0f);
+    _radius.assign(size, paddingRadius);
+
+    if (!children.empty()) _origin = children[0].bound.center;
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        _expandBound(children[i].bound);
+        _appendBound(i, children[i].bound);
+    }
+}
+
+void BatchCullGroup::_expandBound(const dsphere& childBound)
+{
+    // a child without a valid bound can't be culled, so neither can the group
+    if (!childBound.valid()) _unbounded = true;
+    if (_unbounded)
+    {
+        bound.reset();
+        return;
+    }
+
+    if (!bound.valid())
+    {
+        bound = childBound;
+        return;
+    }
+
+    dvec3 delta = childBound.center - bound.center;
+    double d = length(delta);
+
+    // child already enclosed
+    if (d + childBound.radius <= bound.radius) return;
+
+    // child encloses the current bound
+    if (d + bound.radius <= childBound.radius)
+    {
+        bound = childBound;
+        return;
+    }
+
+    double newRadius = (d + bound.radius + childBound.radius) * 0.5;
+    bound.center = bound.center + delta * ((newRadius - bound.radius) / d);
+    bound.radius = newRadius;
+}
+
+void BatchCullGroup::_appendBound(size_t index, const dsphere& childBound)
+{
+    if (index >= _x.size())
+    {
+        // grow to the block of 4 entries containing index, padding with a negative radius that always fails the intersection test
+        size_t size = ((index + 4) / 4) * 4;
+        _x.resize(size, 0.0f);
+        _y.resize(size, 0.0f);
+        _z.resize(size, 0.0f);
+        _radius.resize(size, paddingRadius);
+    }
+
+    if (!childBound.valid())
+    {
+        // children without a valid bound are always traversed, so use a radius that always passes the intersection test
+        _x[index] = 0.0f;
+        _y[index] = 0.0f;
+        _z[index] = 0.0f;
+        _radius[index] = unboundedRadius;
+        return;
+    }
+
+    dvec3 center = childBound.center - _origin;
+    _x[index] = static_cast<float>(center.x);
+    _y[index] = static_cast<float>(center.y);
+    _z[index] = static_cast<float>(center.z);
+
+    // pad the radius by the worst case rounding error of the float plane test, which grows with the distance from the origin,
+    // so that children far from the origin aren't culled while still visible
+    double padding = errorScale * (std::abs(center.x) + std::abs(center.y) + std::abs(center.z) + childBound.radius);
+    _radius[index] = std::nextafter(static_cast<float>(childBound.radius + padding), std::numeric_limits<float>::max());
+}
+
+uint64_t BatchCullGroup::intersect(const dplane* planes, size_t numPlanes, size_t firstChild) const
+{
+    if (numPlanes > maxNumPlanes) numPlanes = maxNumPlanes;
+
+    // planes relative to the origin of the child bounds arrays, so they can be tested in float without loss of precision
+    float nx[maxNumPlanes], ny[maxNumPlanes], nz[maxNumPlanes], nd[maxNumPlanes];
+    for (size_t p = 0; p < numPlanes; ++p)
+    {
+        const auto& plane = planes[p];
+        nx[p] = static_cast<float>(plane.n.x);
+        ny[p] = static_cast<float>(plane.n.y);
+        nz[p] = static_cast<float>(plane.n.z);
+
+        // move the plane outwards by the rounding error of its distance from the origin
+        double distance = dot(plane.n, _origin) + plane.p;
+        nd[p] = static_cast<float>(distance + std::abs(distance) * errorScale);
+    }
+
+    uint64_t mask = 0;
+    size_t endChild = std::min(firstChild + 64, _x.size());
+    for (size_t i = firstChild; i < endChild; i += 4)
+    {
+        uint32_t blockMask = 0;
+
+#if defined(VSG_BATCH_CULL_SSE2)
+        __m128 x = _mm_loadu_ps(&_x[i]);
+        __m128 y = _mm_loadu_ps(&_y[i]);
+        __m128 z = _mm_loadu_ps(&_z[i]);
+        __m128 r = _mm_loadu_ps(&_radius[i]);
+        __m128 zero = _mm_setzero_ps();
+        __m128 inside = _mm_cmpge_ps(r, zero);
+        for (size_t p = 0; p < numPlanes; ++p)
+        {
+            __m128 d = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(nx[p])), _mm_mul_ps(y, _mm_set1_ps(ny[p])));
+            d = _mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(nz[p])));
+            d = _mm_add_ps(d, _mm_add_ps(r, _mm_set1_ps(nd[p])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, zero));
+        }
+        blockMask = static_cast<uint32_t>(_mm_movemask_ps(inside));
+#elif defined(VSG_BATCH_CULL_NEON)
+        float32x4_t x = vld1q_f32(&_x[i]);
+        float32x4_t y = vld1q_f32(&_y[i]);
+        float32x4_t z = vld1q_f32(&_z[i]);
+        float32x4_t r = vld1q_f32(&_radius[i]);
+        float32x4_t zero = vdupq_n_f32(0.0f);
+        uint32x4_t inside = vcgeq_f32(r, zero);
+        for (size_t p = 0; p < numPlanes; ++p)
+        {
+            float32x4_t d = vaddq_f32(r, vdupq_n_f32(nd[p]));
+            d = vmlaq_n_f32(d, x, nx[p]);
+            d = vmlaq_n_f32(d, y, ny[p]);
+            d = vmlaq_n_f32(d, z, nz[p]);
+            inside = vandq_u32(inside, vcgeq_f32(d, zero));
+        }
+        const uint32_t bits[4] = {1, 2, 4, 8};
+        blockMask = vaddvq_u32(vandq_u32(inside, vld1q_u32(bits)));
+#else
+        for (size_t j = 0; j < 4; ++j)
+        {
+            float r = _radius[i + j];
+            bool inside = r >= 0.0f;
+            for (size_t p = 0; p < numPlanes; ++p)
+            {
+                float d = _x[i + j] * nx[p] + _y[i + j] * ny[p] + _z[i + j] * nz[p] + (r + nd[p]);
+                inside = inside && (d >= 0.0f);
+            }
+            if (inside) blockMask |= (1u << j);
+        }
+#endif
+
+        mask |= static_cast<uint64_t>(blockMask) << (i - firstChild);
+    }
+
+    return mask;
+}
+
+void BatchCullGroup::read(Input& input)
+{
+    Node::read(input);
+
+    input.read("bound", bound);
+
+    children.resize(input.readValue<uint32_t>("children"));
+    for (auto& child : children)
+    {
+        input.read("child.bound", child.bound);
+        input.read("child.node", child.node);
+    }
+
+    dirty();
+}
+
+void BatchCullGroup::write(Output& output) const
+{
+    Node::write(output);
+
+    output.write("bound", bound);
+
+    output.writeValue<uint32_t>("children", children.size());
+    for (auto& child : children)
+    {
+        output.write("child.bound", child.bound);
+        output.write("child.node", child.node);
+    }
+}
@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/State.h>
 
 #include <algorithm>
+#include <cstring>
 
 using namespace vsg;
 
@@ -25,7 +26,8 @@ Bin::Bin()
 Bin::Bin(const Bin& rhs, const CopyOp& copyop) :
     Inherit(rhs, copyop),
     binNumber(rhs.binNumber),
-    sortOrder(rhs.sortOrder)
+    sortOrder(rhs.sortOrder),
+    reuseSortOrder(rhs.reuseSortOrder)
 {
 }
 
@@ -46,11 +48,13 @@ int Bin::compare(const Object& rhs_object) const
 
     const auto& rhs = static_cast<decltype(*this)>(rhs_object);
     if ((result = compare_value(binNumber, rhs.binNumber)) != 0) return result;
-    return compare_value(sortOrder, rhs.sortOrder);
+    if ((result = compare_value(sortOrder, rhs.sortOrder)) != 0) return result;
+    return compare_value(reuseSortOrder, rhs.reuseSortOrder);
 }
 
 void Bin::clear()
 {
+    // note, std::vector::clear() retains capacity so the containers don't reallocate from frame to frame
     _matrices.clear();
     _stateCommands.clear();
     _elements.clear();
@@ -106,23 +110,134 @@ void Bin::add(State* state, double value, const Node* node)
     _elements.push_back(element);
 }
 
+void Bin::_sort() const
+{
+    // restore the previous frame's order when the number of elements is unchanged, then fix up any elements that are out of order.
+    if (reuseSortOrder && _previousOrder.size() == _binElements.size())
+    {
+        _sortBuffer.swap(_binElements);
+        _binElements.resize(_sortBuffer.size());
+        for (size_t i = 0; i < _previousOrder.size(); ++i)
+        {
+            _binElements[i] = _sortBuffer[_previousOrder[i]];
+        }
+
+        if (!_insertionSort()) _radixSort();
+    }
+    else
+    {
+        _radixSort();
+    }
+
+    if (reuseSortOrder)
+    {
+        _previousOrder.resize(_binElements.size());
+        for (size_t i = 0; i < _binElements.size(); ++i)
+        {
+            _previousOrder[i] = _binElements[i].second;
+        }
+    }
+    else
+    {
+        _previousOrder.clear();
+    }
+}
+
+bool Bin::_insertionSort() const
+{
+    // limit the number of element moves so that a significant change in order falls back to the radix sort
+    size_t maxMoves = _binElements.size() * 4;
+    size_t numMoves = 0;
+
+    auto before = [&](const KeyIndex& lhs, const KeyIndex& rhs) { return (sortOrder == ASCENDING) ? (lhs.first < rhs.first) : (rhs.first < lhs.first); };
+
+    for (size_t i = 1; i < _binElements.size(); ++i)
+    {
+        if (!before(_binElements[i], _binElements[i - 1])) continue;
+
+        auto keyIndex = _binElements[i];
+        size_t j = i;
+        for (; j > 0 && before(keyIndex, _binElements[j - 1]); --j)
+        {
+            _binElements[j] = _binElements[j - 1];
+        }
+        _binElements[j] = keyIndex;
+
+        numMoves += (i - j);
+        if (numMoves > maxMoves) return false;
+    }
+    return true;
+}
+
+void Bin::_radixSort() const
+{
+    size_t size = _binElements.size();
+
+    // small bins are quicker to sort with a comparison sort
+    if (size < 256)
+    {
+        if (sortOrder == ASCENDING)
+            std::stable_sort(_binElements.begin(), _binElements.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return lhs.first < rhs.first; });
+        else
+            std::stable_sort(_binElements.begin(), _binElements.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return rhs.first < lhs.first; });
+        return;
+    }
+
+    // map the float keys to unsigned integers that sort in the same order, inverting them for a descending sort
+    _sortKeys.resize(size * 2);
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &_binElements[i].first, sizeof(uint32_t));
+        bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        _sortKeys[i] = (sortOrder == ASCENDING) ? bits : ~bits;
+    }
+
+    // least significant digit radix sort, 4 passes of 8 bits, sorting the keys alongside the elements
+    _sortBuffer.resize(size);
+
+    auto* srcElements = _binElements.data();
+    auto* dstElements = _sortBuffer.data();
+    auto* srcKeys = _sortKeys.data();
+    auto* dstKeys = _sortKeys.data() + size;
+
+    for (uint32_t shift = 0; shift < 32; shift += 8)
+    {
+        size_t counts[256] = {};
+        for (size_t i = 0; i < size; ++i) ++counts[(srcKeys[i] >> shift) & 0xff];
+
+        // skip the pass if all the keys share the same digit
+        if (counts[(srcKeys[0] >> shift) & 0xff] == size) continue;
+
+        size_t offset = 0;
+        for (auto& count : counts)
+        {
+            size_t c = count;
+            count = offset;
+            offset += c;
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            size_t pos = counts[(srcKeys[i] >> shift) & 0xff]++;
+            dstElements[pos] = srcElements[i];
+            dstKeys[pos] = srcKeys[i];
+        }
+
+        std::swap(srcElements, dstElements);
+        std::swap(srcKeys, dstKeys);
+    }
+
+    if (srcElements != _binElements.data()) _binElements.swap(_sortBuffer);
+}
+
 void Bin::traverse(RecordTraversal& rt) const
 {
     //debug("Bin::traverse(RecordTraversal& visitor) ", sortOrder, " ", _binElements.size());
 
     auto state = rt.getState();
 
-    switch (sortOrder)
-    {
-    case (ASCENDING):
-        std::sort(_binElements.begin(), _binElements.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return lhs.first < rhs.first; });
-        break;
-    case (DESCENDING):
-        std::sort(_binElements.begin(), _binElements.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return rhs.first < lhs.first; });
-        break;
-    case (NO_SORT):
-        break;
-    }
+    if (sortOrder != NO_SORT) _sort();
 
     uint32_t previousMatrixIndex = static_cast<uint32_t>(_matrices.size());
     //uint32_t previousStateCommandIndex = _stateCommands.size();
@@ -173,6 +288,11 @@ void Bin::read(Input& input)
 
     input.read("binNumber", binNumber);
     input.read("sortOrder", sortOrder);
+
+    if (input.version_greater_equal(1, 1, 15))
+    {
+        input.read("reuseSortOrder", reuseSortOrder);
+    }
 }
 
 void Bin::write(Output& output) const
@@ -181,4 +301,9 @@ void Bin::write(Output& output) const
 
     output.write("binNumber", binNumber);
     output.write("sortOrder", sortOrder);
+
+    if (output.version_greater_equal(1, 1, 15))
+    {
+        output.write("reuseSortOrder", reuseSortOrder);
+    }
 }
@@ -0,0 +1,483 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/Camera.h>
+#include <vsg/app/RecordTraversal.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/stream.h>
+#include <vsg/nodes/InstanceCulling.h>
+#include <vsg/nodes/InstanceDrawIndexed.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
+
+using namespace vsg;
+
+namespace
+{
+    // attributeMask bits
+    constexpr uint32_t ROTATIONS_BIT = 1 << 0;
+    constexpr uint32_t SCALES_BIT = 1 << 1;
+    constexpr uint32_t COLORS_BIT = 1 << 2;
+    constexpr uint32_t COLOR_COMPONENTS_SHIFT = 8;
+
+    // layout must match the push_constant block in the compute shader, and fit within the 128 bytes guaranteed by Vulkan.
+    struct PushConstants
+    {
+        vec4 planes[5];
+        vec4 lodScale;
+        vec4 bound;
+        float minimumScreenHeightRatio;
+        float maximumScreenHeightRatio;
+        uint32_t instanceCount;
+        uint32_t attributeMask;
+    };
+    static_assert(sizeof(PushConstants) == 128);
+    static_assert(POLYTOPE_SIZE <= 5);
+
+    const char* instanceCulling_comp = R"(#version 450
+
+layout(local_size_x = 64) in;
+
+layout(push_constant) uniform PushConstants {
+    vec4 planes[5];
+    vec4 lodScale;
+    vec4 bound;
+    float minimumScreenHeightRatio;
+    float maximumScreenHeightRatio;
+    uint instanceCount;
+    uint attributeMask;
+} pc;
+
+struct DrawIndexedIndirectCommand
+{
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer SourceTranslations { float sourceTranslations[]; };
+layout(std430, set = 0, binding = 1) readonly buffer SourceRotations { vec4 sourceRotations[]; };
+layout(std430, set = 0, binding = 2) readonly buffer SourceScales { float sourceScales[]; };
+layout(std430, set = 0, binding = 3) readonly buffer SourceColors { float sourceColors[]; };
+layout(std430, set = 0, binding = 4) writeonly buffer Translations { float translations[]; };
+layout(std430, set = 0, binding = 5) writeonly buffer Rotations { vec4 rotations[]; };
+layout(std430, set = 0, binding = 6) writeonly buffer Scales { float scales[]; };
+layout(std430, set = 0, binding = 7) writeonly buffer Colors { float colors[]; };
+layout(std430, set = 0, binding = 8) buffer DrawCommands { DrawIndexedIndirectCommand drawCommands[]; };
+
+vec3 rotate(vec4 q, vec3 v)
+{
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+void main()
+{
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= pc.instanceCount) return;
+
+    vec3 translation = vec3(sourceTranslations[i * 3], sourceTranslations[i * 3 + 1], sourceTranslations[i * 3 + 2]);
+    vec4 rotation = ((pc.attributeMask & 1) != 0) ? sourceRotations[i] : vec4(0.0, 0.0, 0.0, 1.0);
+    vec3 scale = ((pc.attributeMask & 2) != 0) ? vec3(sourceScales[i * 3], sourceScales[i * 3 + 1], sourceScales[i * 3 + 2]) : vec3(1.0, 1.0, 1.0);
+
+    vec3 center = translation + rotate(rotation, scale * pc.bound.xyz);
+    float radius = pc.bound.w * max(abs(scale.x), max(abs(scale.y), abs(scale.z)));
+
+    // view frustum cull
+    for (int p = 0; p < 5; ++p)
+    {
+        if (dot(pc.planes[p].xyz, center) + pc.planes[p].w < -radius) return;
+    }
+
+    // LOD cull
+    float lodDistance = abs(dot(pc.lodScale.xyz, center) + pc.lodScale.w);
+    if (radius <= lodDistance * pc.minimumScreenHeightRatio || radius > lodDistance * pc.maximumScreenHeightRatio) return;
+
+    uint index = atomicAdd(drawCommands[0].instanceCount, 1);
+
+    translations[index * 3] = translation.x;
+    translations[index * 3 + 1] = translation.y;
+    translations[index * 3 + 2] = translation.z;
+
+    if ((pc.attributeMask & 1) != 0) rotations[index] = rotation;
+
+    if ((pc.attributeMask & 2) != 0)
+    {
+        scales[index * 3] = scale.x;
+        scales[index * 3 + 1] = scale.y;
+        scales[index * 3 + 2] = scale.z;
+    }
+
+    if ((pc.attributeMask & 4) != 0)
+    {
+        uint numComponents = (pc.attributeMask >> 8) & 0xff;
+        for (uint c = 0; c < numComponents; ++c)
+        {
+            colors[index * numComponents + c] = sourceColors[i * numComponents + c];
+        }
+    }
+}
+)";
+
+    // collect the InstanceDrawIndexed in a subgraph, marking them and the nodes above them for duplication so that the
+    // indirect draw commands can be assigned without modifying the original, potentially shared, subgraph.
+    struct CollectInstanceDrawIndexed : public Visitor
+    {
+        ref_ptr<Duplicate> duplicate = ref_ptr<Duplicate>(new Duplicate);
+        std::vector<const Node*> nodePath;
+
+        void apply(Node& node) override
+        {
+            nodePath.push_back(&node);
+            node.traverse(*this);
+            nodePath.pop_back();
+        }
+
+        void apply(InstanceDrawIndexed& instanceDrawIndexed) override
+        {
+            for (auto node : nodePath) duplicate->insert(node);
+            duplicate->insert(&instanceDrawIndexed);
+        }
+    };
+
+    struct CollectDuplicatedInstanceDrawIndexed : public Visitor
+    {
+        std::vector<ref_ptr<InstanceDrawIndexed>> drawables;
+
+        void apply(Node& node) override
+        {
+            node.traverse(*this);
+        }
+
+        void apply(InstanceDrawIndexed& instanceDrawIndexed) override
+        {
+            drawables.emplace_back(&instanceDrawIndexed);
+        }
+    };
+
+    /// child of the culledInstances InstanceNode, records the culled subgraph for the views rendered from the camera's viewpoint, and the
+    /// unculled instances for views that inherit their viewpoint such as shadow map views, as the visible set differs between them.
+    class SelectCulledInstances : public Inherit<Node, SelectCulledInstances>
+    {
+    public:
+        SelectCulledInstances(ref_ptr<Node> in_culled, ref_ptr<InstanceNode> in_instances) :
+            culled(in_culled),
+            instances(in_instances) {}
+
+        ref_ptr<Node> culled;
+        ref_ptr<InstanceNode> instances;
+
+        void traverse(Visitor& visitor) override { culled->accept(visitor); }
+        void traverse(ConstVisitor& visitor) const override { culled->accept(visitor); }
+        void traverse(RecordTraversal& visitor) const override
+        {
+            if (visitor.getState()->inheritViewForLODScaling)
+                instances->accept(visitor);
+            else
+                culled->accept(visitor);
+        }
+    };
+    VSG_type_name(SelectCulledInstances);
+} // namespace
+
+InstanceCulling::InstanceCulling() :
+    culledInstances(InstanceNode::create())
+{
+}
+
+InstanceCulling::InstanceCulling(const InstanceCulling& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    camera(copyop(rhs.camera)),
+    instances(copyop(rhs.instances)),
+    culledInstances(copyop(rhs.culledInstances)),
+    matrix(rhs.matrix),
+    bound(rhs.bound),
+    minimumScreenHeightRatio(rhs.minimumScreenHeightRatio),
+    maximumScreenHeightRatio(rhs.maximumScreenHeightRatio)
+{
+}
+
+InstanceCulling::InstanceCulling(ref_ptr<Camera> in_camera, ref_ptr<InstanceNode> in_instances, const dsphere& in_bound) :
+    camera(in_camera),
+    instances(in_instances),
+    culledInstances(InstanceNode::create()),
+    bound(in_bound)
+{
+    if (instances) culledInstances->child = instances->child;
+}
+
+InstanceCulling::~InstanceCulling()
+{
+}
+
+int InstanceCulling::compare(const Object& rhs_object) const
+{
+    int result = Command::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_pointer(camera, rhs.camera)) != 0) return result;
+    if ((result = compare_pointer(instances, rhs.instances)) != 0) return result;
+    if ((result = compare_pointer(culledInstances, rhs.culledInstances)) != 0) return result;
+    if ((result = compare_value(matrix, rhs.matrix)) != 0) return result;
+    if ((result = compare_value(bound, rhs.bound)) != 0) return result;
+    if ((result = compare_value(minimumScreenHeightRatio, rhs.minimumScreenHeightRatio)) != 0) return result;
+    return compare_value(maximumScreenHeightRatio, rhs.maximumScreenHeightRatio);
+}
+
+void InstanceCulling::read(Input& input)
+{
+    Command::read(input);
+
+    input.read("camera", camera);
+    input.read("instances", instances);
+    input.read("culledInstances", culledInstances);
+    input.read("matrix", matrix);
+    input.read("bound", bound);
+    input.read("minimumScreenHeightRatio", minimumScreenHeightRatio);
+    input.read("maximumScreenHeightRatio", maximumScreenHeightRatio);
+}
+
+void InstanceCulling::write(Output& output) const
+{
+    Command::write(output);
+
+    output.write("camera", camera);
+    output.write("instances", instances);
+    if (auto select = culledInstances ? culledInstances->child.cast<SelectCulledInstances>() : ref_ptr<SelectCulledInstances>{})
+    {
+        // write the culled subgraph in place of the internal SelectCulledInstances node
+        auto culledInstancesCopy = InstanceNode::create(*culledInstances);
+        culledInstancesCopy->child = select->culled;
+        output.write("culledInstances", culledInstancesCopy);
+    }
+    else
+    {
+        output.write("culledInstances", culledInstances);
+    }
+    output.write("matrix", matrix);
+    output.write("bound", bound);
+    output.write("minimumScreenHeightRatio", minimumScreenHeightRatio);
+    output.write("maximumScreenHeightRatio", maximumScreenHeightRatio);
+}
+
+void InstanceCulling::compile(Context& context)
+{
+    if (_bindComputePipeline || !instances || !instances->translations || !culledInstances) return;
+
+    auto sourceTranslations = instances->translations->data;
+    if (!sourceTranslations)
+    {
+        warn("InstanceCulling::compile() instances->translations requires data.");
+        return;
+    }
+
+    uint32_t instanceCount = instances->instanceCount > 0 ? instances->instanceCount : static_cast<uint32_t>(sourceTranslations->valueCount());
+
+    // the source instances are recorded directly by views that inherit their viewpoint
+    instances->compile(context);
+
+    // duplicate the InstanceDrawIndexed that will draw the culled instances, and the nodes above them, so their DrawIndexedIndirectCommand
+    // can be assigned without affecting other users of the subgraph, sharing the state and arrays with the original subgraph.
+    if (!culledInstances->child) culledInstances->child = instances->child;
+    if (!culledInstances->child)
+    {
+        warn("InstanceCulling::compile() no culledInstances subgraph.");
+        return;
+    }
+
+    CollectInstanceDrawIndexed collectOriginals;
+    culledInstances->child->accept(collectOriginals);
+
+    auto culledChild = culledInstances->child->clone(CopyOp{collectOriginals.duplicate}).cast<Node>();
+
+    CollectDuplicatedInstanceDrawIndexed collect;
+    if (culledChild) culledChild->accept(collect);
+
+    if (collect.drawables.empty())
+    {
+        warn("InstanceCulling::compile() no InstanceDrawIndexed found in culledInstances subgraph.");
+        return;
+    }
+
+    culledInstances->child = SelectCulledInstances::create(culledChild, instances);
+
+    _drawCommandsData = DrawIndexedIndirectCommandArray::create(collect.drawables.size());
+    auto dc_itr = _drawCommandsData->begin();
+    for (auto& drawable : collect.drawables)
+    {
+        auto& drawCommand = *(dc_itr++);
+        drawCommand.indexCount = drawable->indexCount;
+        drawCommand.instanceCount = 0;
+        drawCommand.firstIndex = drawable->firstIndex;
+        drawCommand.vertexOffset = static_cast<int32_t>(drawable->vertexOffset);
+        drawCommand.firstInstance = 0;
+    }
+
+    auto device = context.device;
+    VkDeviceSize drawCommandsSize = _drawCommandsData->dataSize();
+    auto drawCommandsBuffer = createBufferAndMemory(device, drawCommandsSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    _drawCommands = BufferInfo::create(drawCommandsBuffer, 0, drawCommandsSize);
+
+    // host visible copy of the initial draw commands, copied to the draw commands each frame to reset them
+    auto drawCommandsSource = createHostVisibleBuffer(device, DataList{_drawCommandsData}, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE);
+    copyDataListToBuffers(device, drawCommandsSource);
+    _drawCommandsSource = drawCommandsSource.front();
+
+    for (size_t i = 0; i < collect.drawables.size(); ++i)
+    {
+        collect.drawables[i]->indirectCommand = BufferInfo::create(drawCommandsBuffer, i * sizeof(DrawIndexedIndirectCommand), sizeof(DrawIndexedIndirectCommand));
+    }
+
+    // source arrays are uploaded as storage buffers by the DescriptorBuffer, output arrays are written by the compute shader and read as vertex arrays
+    auto createArrays = [&](const ref_ptr<BufferInfo>& source, ref_ptr<BufferInfo>& output, uint32_t bit) -> ref_ptr<BufferInfo> {
+        if (!source || !source->data) return {};
+
+        VkDeviceSize size = static_cast<VkDeviceSize>(source->data->stride()) * instanceCount;
+        auto buffer = createBufferAndMemory(device, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        output = BufferInfo::create(buffer, 0, size);
+
+        _attributeMask |= bit;
+        return BufferInfo::create(source->data);
+    };
+
+    culledInstances->firstInstance = 0;
+    culledInstances->instanceCount = instanceCount;
+
+    _attributeMask = 0;
+    auto translations = createArrays(instances->translations, culledInstances->translations, 0);
+    auto rotations = createArrays(instances->rotations, culledInstances->rotations, ROTATIONS_BIT);
+    auto scales = createArrays(instances->scales, culledInstances->scales, SCALES_BIT);
+    auto colors = createArrays(instances->colors, culledInstances->colors, COLORS_BIT);
+    if (colors) _attributeMask |= (colors->data->stride() / sizeof(float)) << COLOR_COMPONENTS_SHIFT;
+
+    // bindings for absent attributes alias the translations, the shader doesn't access them
+    auto storageBuffer = [&](uint32_t binding, const ref_ptr<BufferInfo>& bufferInfo, const ref_ptr<BufferInfo>& fallback) {
+        return DescriptorBuffer::create(BufferInfoList{bufferInfo ? bufferInfo : fallback}, binding, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    };
+
+    Descriptors descriptors{
+        storageBuffer(0, translations, translations),
+        storageBuffer(1, rotations, translations),
+        storageBuffer(2, scales, translations),
+        storageBuffer(3, colors, translations),
+        storageBuffer(4, culledInstances->translations, culledInstances->translations),
+        storageBuffer(5, culledInstances->rotations, culledInstances->translations),
+        storageBuffer(6, culledInstances->scales, culledInstances->translations),
+        storageBuffer(7, culledInstances->colors, culledInstances->translations),
+        storageBuffer(8, _drawCommands, _drawCommands)};
+
+    DescriptorSetLayoutBindings bindings;
+    for (uint32_t binding = 0; binding < descriptors.size(); ++binding)
+    {
+        bindings.push_back(VkDescriptorSetLayoutBinding{binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr});
+    }
+
+    auto descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    auto pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{descriptorSetLayout}, PushConstantRanges{{VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(sizeof(PushConstants))}});
+    auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", instanceCulling_comp);
+
+    _bindComputePipeline = BindComputePipeline::create(ComputePipeline::create(pipelineLayout, computeShader));
+    _bindDescriptorSet = BindDescriptorSet::create(VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, DescriptorSet::create(descriptorSetLayout, descriptors));
+
+    _bindComputePipeline->compile(context);
+    _bindDescriptorSet->compile(context);
+}
+
+void InstanceCulling::record(CommandBuffer& commandBuffer) const
+{
+    if (!_bindComputePipeline) return;
+
+    auto deviceID = commandBuffer.deviceID;
+    VkCommandBuffer cmdBuffer{commandBuffer};
+    VkBuffer drawCommandsBuffer = _drawCommands->buffer->vk(deviceID);
+
+    // previous draws must have finished reading the draw commands and instance arrays before they are reset and rewritten
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = 0;
+    memoryBarrier.dstAccessMask = 0;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    if (!camera || culledInstances->instanceCount == 0)
+    {
+        // nothing to cull, so zero the draw commands so the indirect draws don't draw anything
+        vkCmdFillBuffer(cmdBuffer, drawCommandsBuffer, _drawCommands->offset, _drawCommands->range, 0);
+
+        memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+        return;
+    }
+
+    // set up the frustum and LOD scale in the local coordinate frame of the instances, matching RecordTraversal/State
+    auto projection = camera->projectionMatrix->transform();
+    auto modelview = camera->viewMatrix->transform() * matrix;
+
+    Frustum frustum(Frustum(), projection * modelview);
+    frustum.computeLodScale(projection, modelview);
+
+    PushConstants pushConstants;
+    for (auto& plane : pushConstants.planes) plane.set(0.0f, 0.0f, 0.0f, 1.0f);
+    for (int i = 0; i < POLYTOPE_SIZE; ++i) pushConstants.planes[i] = vec4(frustum.face[i].vec);
+    pushConstants.lodScale = vec4(frustum.lodScale);
+    pushConstants.bound.set(static_cast<float>(bound.x), static_cast<float>(bound.y), static_cast<float>(bound.z), static_cast<float>(bound.radius));
+    pushConstants.minimumScreenHeightRatio = minimumScreenHeightRatio;
+    pushConstants.maximumScreenHeightRatio = maximumScreenHeightRatio;
+    pushConstants.instanceCount = culledInstances->instanceCount;
+    pushConstants.attributeMask = _attributeMask;
+
+    // reset the draw commands from the host visible copy, zeroing the instanceCount. vkCmdUpdateBuffer is limited to 65536 bytes so isn't used.
+    VkBufferCopy region{_drawCommandsSource->offset, _drawCommands->offset, _drawCommands->range};
+    vkCmdCopyBuffer(cmdBuffer, _drawCommandsSource->buffer->vk(deviceID), drawCommandsBuffer, 1, &region);
+
+    memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    _bindComputePipeline->record(commandBuffer);
+    _bindDescriptorSet->record(commandBuffer);
+    vkCmdPushConstants(cmdBuffer, _bindComputePipeline->pipeline->layout->vk(deviceID), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
+    vkCmdDispatch(cmdBuffer, (pushConstants.instanceCount + workgroupSize - 1) / workgroupSize, 1, 1);
+
+    VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    VkAccessFlags dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+
+    if (_drawCommandsData->size() > 1)
+    {
+        // the shader only counts instances in the first draw command, so copy the instanceCount to the others
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+        VkDeviceSize instanceCountOffset = _drawCommands->offset + offsetof(DrawIndexedIndirectCommand, instanceCount);
+        std::vector<VkBufferCopy> regions(_drawCommandsData->size() - 1);
+        for (size_t i = 0; i < regions.size(); ++i)
+        {
+            regions[i] = VkBufferCopy{instanceCountOffset, instanceCountOffset + (i + 1) * sizeof(DrawIndexedIndirectCommand), sizeof(uint32_t)};
+        }
+        vkCmdCopyBuffer(cmdBuffer, drawCommandsBuffer, drawCommandsBuffer, static_cast<uint32_t>(regions.size()), regions.data());
+
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = dstAccessMask;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, dstStageMask, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+    else
+    {
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = dstAccessMask;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStageMask, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+}
@@ -30,7 +30,8 @@ InstanceDrawIndexed::InstanceDrawIndexed(const InstanceDrawIndexed& rhs, const C
     vertexOffset(rhs.vertexOffset),
     firstBinding(rhs.firstBinding),
     arrays(copyop(rhs.arrays)),
-    indices(copyop(rhs.indices))
+    indices(copyop(rhs.indices)),
+    indirectCommand(copyop(rhs.indirectCommand))
 {
 }
 
@@ -49,7 +50,8 @@ int InstanceDrawIndexed::compare(const Object& rhs_object) const
     if ((result = compare_value(vertexOffset, rhs.vertexOffset)) != 0) return result;
     if ((result = compare_value(firstBinding, rhs.firstBinding)) != 0) return result;
     if ((result = compare_pointer_container(arrays, rhs.arrays)) != 0) return result;
-    return compare_pointer(indices, rhs.indices);
+    if ((result = compare_pointer(indices, rhs.indices)) != 0) return result;
+    return compare_pointer(indirectCommand, rhs.indirectCommand);
 }
 
 void InstanceDrawIndexed::assignArrays(const DataList& arrayData)
@@ -203,5 +205,9 @@ void InstanceDrawIndexed::record(CommandBuffer& commandBuffer) const
     // vsg::info("InstanceDrawIndexed::record(CommandBuffer& commandBuffer) vkCmdDrawIndexed vkBuffers.size() = ", vkBuffers.size(), ", indexCount = ", indexCount, ", instanceNode->instanceCount = ", instanceNode->instanceCount);
 
     vkCmdBindIndexBuffer(cmdBuffer, indices->buffer->vk(deviceID), indices->offset, indexType);
-    vkCmdDrawIndexed(cmdBuffer, indexCount, instanceNode->instanceCount, firstIndex, vertexOffset, instanceNode->firstInstance);
+
+    if (indirectCommand)
+        vkCmdDrawIndexedIndirect(cmdBuffer, indirectCommand->buffer->vk(deviceID), indirectCommand->offset, 1, sizeof(VkDrawIndexedIndirectCommand));
+    else
+        vkCmdDrawIndexed(cmdBuffer, indexCount, instanceNode->instanceCount, firstIndex, vertexOffset, instanceNode->firstInstance);
 }
@@ -107,7 +107,8 @@ ComputePipeline::Implementation::Implementation(Context& context, Device* device
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineInfo.pNext = nullptr;
 
-    if (VkResult result = vkCreateComputePipelines(*device, VK_NULL_HANDLE, 1, &pipelineInfo, _device->getAllocationCallbacks(), &_pipeline); result != VK_SUCCESS)
+    VkPipelineCache vk_pipelineCache = context.pipelineCache ? context.pipelineCache->vk() : VK_NULL_HANDLE;
+    if (VkResult result = vkCreateComputePipelines(*device, vk_pipelineCache, 1, &pipelineInfo, _device->getAllocationCallbacks(), &_pipeline); result != VK_SUCCESS)
     {
         throw Exception{"Error: vsg::ComputePipeline failed to create VkPipeline.", result};
     }
@@ -257,7 +257,8 @@ GraphicsPipeline::Implementation::Implementation(Context& context, Device* devic
         pipelineState->apply(context, pipelineInfo);
     }
 
-    VkResult result = vkCreateGraphicsPipelines(*device, VK_NULL_HANDLE, 1, &pipelineInfo, _device->getAllocationCallbacks(), &_pipeline);
+    VkPipelineCache vk_pipelineCache = context.pipelineCache ? context.pipelineCache->vk() : VK_NULL_HANDLE;
+    VkResult result = vkCreateGraphicsPipelines(*device, vk_pipelineCache, 1, &pipelineInfo, _device->getAllocationCallbacks(), &_pipeline);
 
     context.scratchMemory->release();
 
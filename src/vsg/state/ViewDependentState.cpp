@@ -10,7 +10,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/app/RecordTraversal.h>
 #include <vsg/app/View.h>
+#include <vsg/commands/CopyImage.h>
 #include <vsg/commands/PipelineBarrier.h>
 #include <vsg/core/compare.h>
 #include <vsg/io/Logger.h>
@@ -28,6 +30,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/utils/GraphicsPipelineConfigurator.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 using namespace vsg;
 
@@ -57,6 +64,46 @@ namespace vsg
     };
     VSG_type_name(TraverseChildrenOfNode);
 
+    /// restricts the culling of the shadow casters rendered every frame on top of a cached static shadow map to the light space bounds
+    /// of the current view frustum slice, extended toward the light, while leaving the projection matrix to match the cached shadow map.
+    class CullShadowCasters : public Inherit<Node, CullShadowCasters>
+    {
+    public:
+        CullShadowCasters(const ViewDependentState* in_viewDependentState, uint32_t in_index, ref_ptr<Node> in_child) :
+            viewDependentState(in_viewDependentState),
+            index(in_index),
+            child(in_child) {}
+
+        const ViewDependentState* viewDependentState = nullptr;
+        uint32_t index = 0;
+        ref_ptr<Node> child;
+
+        void traverse(Visitor& visitor) override { child->accept(visitor); }
+        void traverse(ConstVisitor& visitor) const override { child->accept(visitor); }
+        void traverse(RecordTraversal& visitor) const override
+        {
+            const auto& shadowMap = viewDependentState->shadowMaps[index];
+            if (!shadowMap.casterCulling)
+            {
+                child->accept(visitor);
+                return;
+            }
+
+            auto state = visitor.getState();
+            auto frustumProjected = state->_frustumProjected;
+
+            // the frustum has no near plane so casters between the light and the view frustum slice are retained
+            state->_frustumProjected.set(state->_frustumUnit, t_mat4<Frustum::value_type>(shadowMap.casterCullingProjectionMatrix));
+            state->pushFrustum();
+
+            child->accept(visitor);
+
+            state->popFrustum();
+            state->_frustumProjected = frustumProjected;
+        }
+    };
+    VSG_type_name(CullShadowCasters);
+
     inline double Cpractical(double n, double f, double i, double m, double lambda)
     {
         double Clog = n * std::pow((f / n), (i / m));
@@ -295,6 +342,16 @@ void ViewDependentState::init(ResourceRequirements& requirements)
     viewportDataBufferInfo = BufferInfo::create(viewportData.get());
     descriptorConfigurator->assignDescriptor("viewportData", BufferInfoList{viewportDataBufferInfo});
 
+    if (clusteredLighting && maxNumberLights > 0 && shaderSet->getDescriptorBinding("lightClusters"))
+    {
+        uint32_t numClusters = lightClusterDimensions.x * lightClusterDimensions.y * lightClusterDimensions.z;
+        lightClusterData = uintArray::create(8 + 2 * numClusters + maxLightClusterIndices, 0u);
+        lightClusterData->setValue("name", "lightClusterData");
+        lightClusterData->properties.dataVariance = DYNAMIC_DATA_TRANSFER_AFTER_RECORD;
+        lightClusterDataBufferInfo = BufferInfo::create(lightClusterData.get());
+        descriptorConfigurator->assignDescriptor("lightClusters", BufferInfoList{lightClusterDataBufferInfo});
+    }
+
     // set up ShadowMaps
     auto shadowMapDirectSampler = Sampler::create();
     shadowMapDirectSampler->minFilter = VK_FILTER_NEAREST;
@@ -390,12 +447,24 @@ void ViewDependentState::init(ResourceRequirements& requirements)
 
     Mask shadowMask = 0x1; // TODO: do we inherit from main scene? how?
 
+    // when caching with dynamic shadow casters the dynamic casters are rendered every frame on top of a copy of the cached static casters
+    bool compositeDynamicCasters = shadowMapCaching && dynamicShadowCasterMask != MASK_OFF;
+    if (shadowMapCaching) shadowMask = compositeDynamicCasters ? dynamicShadowCasterMask : staticShadowCasterMask;
+
+    if (compositeDynamicCasters)
+    {
+        staticShadowDepthImage = createShadowImage(shadowWidth, shadowHeight, maxShadowMaps, VK_FORMAT_D32_SFLOAT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+        shadowDepthImage->usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
+
     auto viewportState = ViewportState::create(VkExtent2D{shadowWidth, shadowHeight});
 
     ref_ptr<View> first_view;
     shadowMaps.resize(maxShadowMaps);
     for (auto& shadowMap : shadowMaps)
     {
+        uint32_t layer = static_cast<uint32_t>(&shadowMap - shadowMaps.data());
+
         if (first_view)
         {
             shadowMap.view = View::create(*first_view);
@@ -408,15 +477,113 @@ void ViewDependentState::init(ResourceRequirements& requirements)
 
         shadowMap.view->mask = shadowMask;
         shadowMap.view->camera = Camera::create();
-        shadowMap.view->addChild(tcon);
+        if (compositeDynamicCasters)
+            shadowMap.view->addChild(CullShadowCasters::create(this, layer, tcon));
+        else
+            shadowMap.view->addChild(tcon);
         shadowMap.view->camera->viewportState = viewportState;
 
         shadowMap.renderGraph = RenderGraph::create();
         shadowMap.renderGraph->addChild(shadowMap.view);
-        preRenderSwitch->addChild(MASK_ALL, shadowMap.renderGraph);
+
+        if (compositeDynamicCasters)
+        {
+            // static casters are rendered into their own layer only when the cache is invalid, then copied to the shadow map layer each frame
+            shadowMap.staticView = View::create(*first_view);
+            shadowMap.staticView->mask = staticShadowCasterMask;
+            shadowMap.staticView->camera = shadowMap.view->camera;
+            shadowMap.staticView->addChild(tcon);
+
+            shadowMap.staticRenderGraph = RenderGraph::create();
+            shadowMap.staticRenderGraph->addChild(shadowMap.staticView);
+
+            shadowMap.staticSwitch = Switch::create();
+            shadowMap.staticSwitch->addChild(MASK_ALL, shadowMap.staticRenderGraph);
+
+            auto toTransferDstBarrier = ImageMemoryBarrier::create(
+                VK_ACCESS_SHADER_READ_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_QUEUE_FAMILY_IGNORED,
+                VK_QUEUE_FAMILY_IGNORED,
+                shadowDepthImage,
+                VkImageSubresourceRange{VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, layer, 1});
+
+            auto copyImage = CopyImage::create();
+            copyImage->srcImage = staticShadowDepthImage;
+            copyImage->srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            copyImage->dstImage = shadowDepthImage;
+            copyImage->dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            copyImage->regions.push_back(VkImageCopy{
+                VkImageSubresourceLayers{VK_IMAGE_ASPECT_DEPTH_BIT, 0, layer, 1}, VkOffset3D{0, 0, 0},
+                VkImageSubresourceLayers{VK_IMAGE_ASPECT_DEPTH_BIT, 0, layer, 1}, VkOffset3D{0, 0, 0},
+                VkExtent3D{shadowWidth, shadowHeight, 1}});
+
+            auto composite = Group::create();
+            composite->addChild(shadowMap.staticSwitch);
+            composite->addChild(PipelineBarrier::create(VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, toTransferDstBarrier));
+            composite->addChild(copyImage);
+            composite->addChild(shadowMap.renderGraph);
+
+            preRenderSwitch->addChild(MASK_ALL, composite);
+        }
+        else
+        {
+            preRenderSwitch->addChild(MASK_ALL, shadowMap.renderGraph);
+        }
     }
 }
 
+void ViewDependentState::dirtyShadowMaps()
+{
+    std::scoped_lock<std::mutex> lock(_dirtyShadowRegionsMutex);
+    _dirtyAllShadowMaps = true;
+}
+
+void ViewDependentState::dirtyShadowMaps(const dbox& worldBounds)
+{
+    std::scoped_lock<std::mutex> lock(_dirtyShadowRegionsMutex);
+    _dirtyShadowRegions.push_back(worldBounds);
+}
+
+bool ViewDependentState::_shadowMapCacheValid(ShadowMap& shadowMap, const dmat4& projView) const
+{
+    // the pending dirty regions are consumed by this check
+    std::vector<dbox> dirtyRegions;
+    dirtyRegions.swap(shadowMap.dirtyRegions);
+    bool dirtyAll = shadowMap.dirtyAll;
+    shadowMap.dirtyAll = false;
+
+    if (!shadowMap.cacheValid || dirtyAll || shadowMap.cachedProjView != projView)
+    {
+        shadowMap.cacheValid = true;
+        shadowMap.cachedProjView = projView;
+        return false;
+    }
+
+    // check if any of the dirty regions overlap the shadow map's light space volume
+    for (const auto& region : dirtyRegions)
+    {
+        dbox clip_bounds;
+        for (int i = 0; i < 8; ++i)
+        {
+            clip_bounds.add(projView * dvec3((i & 1) ? region.max.x : region.min.x,
+                                             (i & 2) ? region.max.y : region.min.y,
+                                             (i & 4) ? region.max.z : region.min.z));
+        }
+
+        if (clip_bounds.max.x >= -1.0 && clip_bounds.min.x <= 1.0 &&
+            clip_bounds.max.y >= -1.0 && clip_bounds.min.y <= 1.0 &&
+            clip_bounds.max.z >= 0.0 && clip_bounds.min.z <= 1.0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void ViewDependentState::update(ResourceRequirements& requirements)
 {
     if (preRenderCommandGraph)
@@ -445,11 +612,22 @@ void ViewDependentState::compile(Context& context)
 
         shadowDepthImage->compile(context);
 
-        uint32_t layer = 0;
-        for (const auto& shadowMap : shadowMaps)
+        if (staticShadowDepthImage) staticShadowDepthImage->compile(context);
+
+        struct AttachmentSettings
         {
+            VkAttachmentLoadOp loadOp;
+            VkImageLayout initialLayout;
+            VkImageLayout finalLayout;
+            VkPipelineStageFlags srcStageMask;
+            VkAccessFlags srcAccessMask;
+            VkPipelineStageFlags dstStageMask;
+            VkAccessFlags dstAccessMask;
+        };
+
+        auto setUpRenderGraph = [&](RenderGraph& rendergraph, ref_ptr<Image> image, uint32_t layer, const AttachmentSettings& settings) {
             // create depth buffer
-            auto depthImageView = ImageView::create(shadowDepthImage, VK_IMAGE_ASPECT_DEPTH_BIT);
+            auto depthImageView = ImageView::create(image, VK_IMAGE_ASPECT_DEPTH_BIT);
             depthImageView->viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
             depthImageView->subresourceRange.baseMipLevel = 0;
             depthImageView->subresourceRange.levelCount = 1;
@@ -460,14 +638,14 @@ void ViewDependentState::compile(Context& context)
             // attachment descriptions
             RenderPass::Attachments attachments(1);
             // Depth attachment
-            attachments[0].format = shadowDepthImage->format;
+            attachments[0].format = image->format;
             attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
-            attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachments[0].loadOp = settings.loadOp;
             attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
             attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
             attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-            attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            attachments[0].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            attachments[0].initialLayout = settings.initialLayout;
+            attachments[0].finalLayout = settings.finalLayout;
 
             AttachmentReference ignoreColorReference = {VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED};
             AttachmentReference depthReference = {0, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
@@ -480,18 +658,24 @@ void ViewDependentState::compile(Context& context)
 
             dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
             dependencies[0].dstSubpass = 0;
-            dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            dependencies[0].srcStageMask = settings.srcStageMask;
             dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-            dependencies[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            dependencies[0].srcAccessMask = settings.srcAccessMask;
             dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            if (settings.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+            {
+                // loading the existing depth values so need to wait on the prior writes before reading the attachment
+                dependencies[0].dstStageMask |= VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+                dependencies[0].dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+            }
             dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
             dependencies[1].srcSubpass = 0;
             dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
             dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            dependencies[1].dstStageMask = settings.dstStageMask;
             dependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            dependencies[1].dstAccessMask = settings.dstAccessMask;
             dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
             auto renderPass = RenderPass::create(context.device, attachments, subpassDescription, dependencies);
@@ -499,13 +683,38 @@ void ViewDependentState::compile(Context& context)
             // Framebuffer
             auto fbuf = Framebuffer::create(renderPass, ImageViews{depthImageView}, extent.width, extent.height, 1);
 
-            auto rendergraph = shadowMap.renderGraph;
-            rendergraph->renderArea.offset = VkOffset2D{0, 0};
-            rendergraph->renderArea.extent = VkExtent2D{extent.width, extent.height};
-            rendergraph->framebuffer = fbuf;
+            rendergraph.renderArea.offset = VkOffset2D{0, 0};
+            rendergraph.renderArea.extent = VkExtent2D{extent.width, extent.height};
+            rendergraph.framebuffer = fbuf;
 
-            rendergraph->clearValues.resize(1);
-            rendergraph->clearValues[0].depthStencil = VkClearDepthStencilValue{0.0f, 0};
+            rendergraph.clearValues.resize(1);
+            rendergraph.clearValues[0].depthStencil = VkClearDepthStencilValue{0.0f, 0};
+        };
+
+        uint32_t layer = 0;
+        for (const auto& shadowMap : shadowMaps)
+        {
+            if (shadowMap.staticRenderGraph)
+            {
+                // static casters cleared and rendered into the static shadow map layer, ready to be copied into the shadow map layer
+                setUpRenderGraph(*shadowMap.staticRenderGraph, staticShadowDepthImage, layer,
+                                 AttachmentSettings{VK_ATTACHMENT_LOAD_OP_CLEAR, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                                                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT});
+
+                // dynamic casters rendered on top of the copy of the static casters
+                setUpRenderGraph(*shadowMap.renderGraph, shadowDepthImage, layer,
+                                 AttachmentSettings{VK_ATTACHMENT_LOAD_OP_LOAD, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                                                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT});
+            }
+            else
+            {
+                setUpRenderGraph(*shadowMap.renderGraph, shadowDepthImage, layer,
+                                 AttachmentSettings{VK_ATTACHMENT_LOAD_OP_CLEAR, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                                                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                                                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT});
+            }
 
             ++layer;
         }
@@ -562,6 +771,38 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
     // https://github.com/vsgopenmw-dev/vsgopenmw/blob/master/files/shaders/lib/view/shadow.glsl
 
     bool requiresPerRenderShadowMaps = false;
+
+    // take the regions marked as dirty since the last frame and pass them on to every cached shadow map,
+    // so that shadow maps not active this frame still get invalidated when they are next used.
+    if (shadowMapCaching)
+    {
+        std::vector<dbox> dirtyShadowRegions;
+        bool dirtyAllShadowMaps = false;
+        {
+            std::scoped_lock<std::mutex> lock(_dirtyShadowRegionsMutex);
+            dirtyShadowRegions.swap(_dirtyShadowRegions);
+            dirtyAllShadowMaps = _dirtyAllShadowMaps;
+            _dirtyAllShadowMaps = false;
+        }
+
+        // beyond this many pending regions it's cheaper to just re-render the shadow map than to keep testing them
+        const size_t maxPendingDirtyRegions = 64;
+        for (auto& shadowMap : shadowMaps)
+        {
+            if (shadowMap.dirtyAll) continue;
+
+            if (dirtyAllShadowMaps || shadowMap.dirtyRegions.size() + dirtyShadowRegions.size() > maxPendingDirtyRegions)
+            {
+                shadowMap.dirtyAll = true;
+                shadowMap.dirtyRegions.clear();
+            }
+            else
+            {
+                shadowMap.dirtyRegions.insert(shadowMap.dirtyRegions.end(), dirtyShadowRegions.begin(), dirtyShadowRegions.end());
+            }
+        }
+    }
+
     uint32_t shadowMapIndex = 0;
     uint32_t numShadowMaps = static_cast<uint32_t>(shadowMaps.size());
     if (preRenderSwitch)
@@ -569,6 +810,45 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
     else
         numShadowMaps = 0;
 
+    // enable rendering of the current shadow map, when caching only render the static shadow casters when the cached shadow map is invalid.
+    auto enableShadowMapRendering = [&](ShadowMap& shadowMap, const dmat4& shadowMapProjView) -> void {
+        if (!shadowMapCaching)
+        {
+            preRenderSwitch->children[shadowMapIndex].mask = MASK_ALL;
+            return;
+        }
+
+        bool cacheValid = _shadowMapCacheValid(shadowMap, shadowMapProjView);
+        if (shadowMap.staticSwitch)
+        {
+            // dynamic casters are rendered every frame on top of the copy of the cached static casters
+            shadowMap.staticSwitch->setAllChildren(!cacheValid);
+            preRenderSwitch->children[shadowMapIndex].mask = MASK_ALL;
+        }
+        else
+        {
+            preRenderSwitch->children[shadowMapIndex].mask = cacheValid ? MASK_OFF : MASK_ALL;
+        }
+    };
+
+    // expand the light space bounds required to cover the view frustum so that the cached shadow map remains valid for small camera movements.
+    auto cacheLightSpaceBounds = [&](ShadowMap& shadowMap, const dbox& ls_bounds) -> dbox {
+        const auto& cached = shadowMap.cachedBounds;
+        bool contained = shadowMap.cacheValid && cached &&
+                         ls_bounds.min.x >= cached.min.x && ls_bounds.min.y >= cached.min.y && ls_bounds.min.z >= cached.min.z &&
+                         ls_bounds.max.x <= cached.max.x && ls_bounds.max.y <= cached.max.y && ls_bounds.max.z <= cached.max.z;
+        if (!contained)
+        {
+            auto margin = (ls_bounds.max - ls_bounds.min) * shadowMapCacheMargin;
+            shadowMap.cachedBounds = dbox(ls_bounds.min - margin, ls_bounds.max + margin);
+        }
+        return shadowMap.cachedBounds;
+    };
+
+    // when caching use a view independent basis for the light space so that cached shadow maps remain valid as the camera rotates
+    dvec3 basis_direction(0.0, 0.0, -1.0);
+    dvec3 basis_up(0.0, 1.0, 0.0);
+
     auto computeFrustumBounds = [&](double n, double f, const dmat4& clipToWorld) -> dbox {
         dbox bounds;
         bounds.add(clipToWorld * dvec3(-1.0, -1.0, n));
@@ -753,8 +1033,8 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         info("      view_direction in world = ", view_direction);
         info("      view_up in world = ", view_up);
 #endif
-        auto light_x_direction = cross(light_direction, view_direction);
-        auto light_x_up = cross(light_direction, view_up);
+        auto light_x_direction = cross(light_direction, shadowMapCaching ? basis_direction : view_direction);
+        auto light_x_up = cross(light_direction, shadowMapCaching ? basis_up : view_up);
 
         auto light_x = (length(light_x_direction) > length(light_x_up)) ? normalize(light_x_direction) : normalize(light_x_up);
         auto light_y = cross(light_x, light_direction);
@@ -772,8 +1052,7 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         }
 
         auto updateCamera = [&](double clip_near_z, double clip_far_z, const dmat4& clipToWorld) -> void {
-            const auto& shadowMap = shadowMaps[shadowMapIndex];
-            preRenderSwitch->children[shadowMapIndex].mask = MASK_ALL;
+            auto& shadowMap = shadowMaps[shadowMapIndex];
 
             const auto& camera = shadowMap.view->camera;
             auto lookAt = camera->viewMatrix.cast<LookAt>();
@@ -783,13 +1062,45 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
             if (!ortho) camera->projectionMatrix = ortho = Orthographic::create();
 
             auto ws_bounds = computeFrustumBounds(clip_near_z, clip_far_z, clipToWorld);
-            auto sm_eye = (ws_bounds.min + ws_bounds.max) * 0.5 - light_z * (0.5 * length(ws_bounds.max - ws_bounds.min));
+            if (shadowMapCaching)
+            {
+                // keep the light space origin near the view frustum slice to retain precision at large world coordinates, such as ECEF,
+                // snapping it to a grid sized by the slice's extents so that it only moves, and invalidates the cache, when the view crosses a grid cell.
+                auto ws_center = (ws_bounds.min + ws_bounds.max) * 0.5;
+                double requiredCellSize = std::exp2(std::ceil(std::log2(std::max(length(ws_bounds.max - ws_bounds.min), 1.0))));
+
+                // allow the slice's extents to vary somewhat without changing the grid, e.g. as the camera rotates
+                double& cellSize = shadowMap.cachedEyeCellSize;
+                bool cellSizeChanged = cellSize < requiredCellSize || cellSize > requiredCellSize * 4.0;
+                if (cellSizeChanged) cellSize = requiredCellSize;
+
+                auto offset = ws_center - shadowMap.cachedEye;
+                if (cellSizeChanged || std::abs(offset.x) > cellSize || std::abs(offset.y) > cellSize || std::abs(offset.z) > cellSize)
+                {
+                    shadowMap.cachedEye.set(std::round(ws_center.x / cellSize) * cellSize, std::round(ws_center.y / cellSize) * cellSize, std::round(ws_center.z / cellSize) * cellSize);
+
+                    // the cached bounds are relative to the previous origin, the change in projView invalidates the cached shadow map
+                    shadowMap.cachedBounds = {};
+                }
+                lookAt->eye = shadowMap.cachedEye;
+            }
+            else
+            {
+                lookAt->eye = (ws_bounds.min + ws_bounds.max) * 0.5 - light_z * (0.5 * length(ws_bounds.max - ws_bounds.min));
+            }
 
-            lookAt->eye = sm_eye;
-            lookAt->center = sm_eye + light_z;
+            lookAt->center = lookAt->eye + light_z;
             lookAt->up = light_y;
 
             auto ls_bounds = computeFrustumBounds(clip_near_z, clip_far_z, lookAt->transform() * clipToWorld);
+            if (shadowMapCaching)
+            {
+                // the dynamic casters rendered each frame only need to cover the view frustum slice, not the expanded cached bounds
+                shadowMap.casterCulling = shadowMap.staticSwitch.valid();
+                shadowMap.casterCullingProjectionMatrix = orthographic(ls_bounds.min.x, ls_bounds.max.x, ls_bounds.min.y, ls_bounds.max.y, -ls_bounds.max.z, -ls_bounds.min.z);
+
+                ls_bounds = cacheLightSpaceBounds(shadowMap, ls_bounds);
+            }
 
             ortho->left = ls_bounds.min.x;
             ortho->right = ls_bounds.max.x;
@@ -800,6 +1111,8 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
 
             dmat4 shadowMapProjView = camera->projectionMatrix->transform() * camera->viewMatrix->transform();
 
+            enableShadowMapRendering(shadowMap, shadowMapProjView);
+
             dmat4 shadowMapTM = scale(0.5, 0.5, 1.0) * translate(1.0, 1.0, shadowMapBias) * shadowMapProjView * inverse_viewMatrix;
 
             // convert tex gen matrix to float matrix and assign to light data
@@ -861,9 +1174,18 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         }
     }
 
+    auto lightRange = [&](const Light* light) -> double {
+        // lights use inverse square fall off so range is where intensity drops below the threshold
+        double intensity = static_cast<double>(light->intensity) * std::max(light->color.r, std::max(light->color.g, light->color.b));
+        return std::sqrt(std::max(intensity, 0.0) / std::max(static_cast<double>(lightClusterIntensityThreshold), 1e-6));
+    };
+
+    _clusterLights.clear();
+
     for (auto& [mv, light] : pointLights)
     {
         auto eye_position = mv * light->position;
+        if (lightClusterData) _clusterLights.push_back(ClusterLight{eye_position, lightRange(light), static_cast<uint32_t>(light_itr - lightData->begin())});
         assignLightData4(light->color.r, light->color.g, light->color.b, light->intensity);
         assignLightData4(static_cast<float>(eye_position.x), static_cast<float>(eye_position.y), static_cast<float>(eye_position.z), 0.0f);
     }
@@ -874,6 +1196,7 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         auto eye_direction = normalize(light->direction * inverse_3x3(mv));
         float cos_innerAngle = static_cast<float>(cos(light->innerAngle));
         float cos_outerAngle = static_cast<float>(cos(light->outerAngle));
+        if (lightClusterData) _clusterLights.push_back(ClusterLight{eye_position, lightRange(light), static_cast<uint32_t>(light_itr - lightData->begin()) | 0x80000000u});
         assignLightData4(light->color.r, light->color.g, light->color.b, light->intensity);
         assignLightData4(static_cast<float>(eye_position.x), static_cast<float>(eye_position.y), static_cast<float>(eye_position.z), cos_innerAngle);
         assignLightData4(static_cast<float>(eye_direction.x), static_cast<float>(eye_direction.y), static_cast<float>(eye_direction.z), cos_outerAngle);
@@ -914,8 +1237,8 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         info("      view_direction in world = ", view_direction);
         info("      view_up in world = ", view_up);
 #endif
-        auto light_x_direction = cross(light_direction, view_direction);
-        auto light_x_up = cross(light_direction, view_up);
+        auto light_x_direction = cross(light_direction, shadowMapCaching ? basis_direction : view_direction);
+        auto light_x_up = cross(light_direction, shadowMapCaching ? basis_up : view_up);
 
         auto light_x = (length(light_x_direction) > length(light_x_up)) ? normalize(light_x_direction) : normalize(light_x_up);
         auto light_y = cross(light_x, light_direction);
@@ -936,8 +1259,7 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         auto light_intensity = light->intensity;
 
         auto updateCamera = [&](double clip_near_z, double clip_far_z, const dmat4& clipToWorld) -> void {
-            const auto& shadowMap = shadowMaps[shadowMapIndex];
-            preRenderSwitch->children[shadowMapIndex].mask = MASK_ALL;
+            auto& shadowMap = shadowMaps[shadowMapIndex];
 
             const auto& camera = shadowMap.view->camera;
             auto lookAt = camera->viewMatrix.cast<LookAt>();
@@ -971,10 +1293,24 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
                              -(right + left) / (right - left), -(top + bottom) / (top - bottom), -zNear / (zFar - zNear), 1.0);
             };
 
-            relativeProjection->matrix = tweakedOrthographic(ls_bounds.min.x, ls_bounds.max.x, ls_bounds.min.y, ls_bounds.max.y, ls_bounds.min.z, ls_bounds.max.z);
+            if (shadowMapCaching)
+            {
+                // use the whole of the spot light's frustum so that it only changes when the light moves
+                relativeProjection->matrix = dmat4();
+
+                // the dynamic casters rendered each frame only need to cover the view frustum, not the whole of the spot light's frustum
+                shadowMap.casterCulling = shadowMap.staticSwitch.valid();
+                shadowMap.casterCullingProjectionMatrix = tweakedOrthographic(ls_bounds.min.x, ls_bounds.max.x, ls_bounds.min.y, ls_bounds.max.y, ls_bounds.min.z, ls_bounds.max.z) * perspective->transform();
+            }
+            else
+            {
+                relativeProjection->matrix = tweakedOrthographic(ls_bounds.min.x, ls_bounds.max.x, ls_bounds.min.y, ls_bounds.max.y, ls_bounds.min.z, ls_bounds.max.z);
+            }
 
             dmat4 shadowMapProjView = camera->projectionMatrix->transform() * camera->viewMatrix->transform();
 
+            enableShadowMapRendering(shadowMap, shadowMapProjView);
+
             dmat4 shadowMapTM = scale(0.5, 0.5, 1.0 + shadowMapBias) * translate(1.0, 1.0, 0.0) * shadowMapProjView * inverse_viewMatrix;
 
             // convert tex gen matrix to float matrix and assign to light data
@@ -1041,6 +1377,8 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         lightData->dirty();
     }
 
+    if (lightClusterData) assignLightClusters(projectionMatrix);
+
     if (requiresPerRenderShadowMaps && preRenderCommandGraph)
     {
         if (rt.instrumentation && !preRenderCommandGraph->instrumentation)
@@ -1053,6 +1391,158 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
     }
 }
 
+void ViewDependentState::assignLightClusters(const dmat4& projectionMatrix) const
+{
+    const auto& dimensions = lightClusterDimensions;
+    uint32_t numClusters = dimensions.x * dimensions.y * dimensions.z;
+    if (lightClusterData->size() < 8 + 2 * numClusters) return;
+
+    uint32_t* header = lightClusterData->data();
+    uint32_t* clusters = header + 8;
+    uint32_t* indices = clusters + 2 * numClusters;
+    uint32_t maxIndices = static_cast<uint32_t>(lightClusterData->size()) - 8 - 2 * numClusters;
+
+    // compute the near and far planes from the projection matrix, handling both reverse and standard depth
+    auto clipToEye = inverse(projectionMatrix);
+    double d0 = -(clipToEye * dvec3(0.0, 0.0, 0.0)).z;
+    double d1 = -(clipToEye * dvec3(0.0, 0.0, 1.0)).z;
+    double n = 0.0, f = 0.0;
+    if (std::isfinite(d0) && std::isfinite(d1))
+    {
+        n = std::min(d0, d1);
+        f = std::max(d0, d1);
+    }
+    else
+    {
+        // an infinite far plane projects to w = 0 so has no finite depth, in which case distribute the depth slices out to the furthest extent of the lights
+        n = std::isfinite(d0) ? d0 : (std::isfinite(d1) ? d1 : 0.0);
+        for (auto& cl : _clusterLights) f = std::max(f, -cl.eye_position.z + cl.range);
+    }
+    n = std::max(n, 1e-6);
+    f = std::max(f, n * (1.0 + 1e-6));
+
+    // depth slices are distributed logarithmically between the near and far planes
+    double sliceScale = static_cast<double>(dimensions.z) / std::log(f / n);
+    double sliceBias = -std::log(n) * sliceScale;
+
+    auto floatBits = [](double value) -> uint32_t {
+        float fv = static_cast<float>(value);
+        uint32_t bits;
+        std::memcpy(&bits, &fv, sizeof(uint32_t));
+        return bits;
+    };
+
+    auto depthSlice = [&](double depth) -> uint32_t {
+        double slice = std::log(depth) * sliceScale + sliceBias;
+        return static_cast<uint32_t>(std::clamp(slice, 0.0, static_cast<double>(dimensions.z - 1)));
+    };
+
+    auto tile = [](double ndc, uint32_t dimension) -> uint32_t {
+        double t = (ndc * 0.5 + 0.5) * static_cast<double>(dimension);
+        return static_cast<uint32_t>(std::clamp(t, 0.0, static_cast<double>(dimension - 1)));
+    };
+
+    struct ClusterRange
+    {
+        uvec3 min;
+        uvec3 max;
+    };
+
+    // compute the range of clusters each light overlaps, conservatively using the screen space bounds of the light's eye space bounding box.
+    auto computeRange = [&](const ClusterLight& cl, ClusterRange& range) -> bool {
+        double zmin = -cl.eye_position.z - cl.range;
+        double zmax = -cl.eye_position.z + cl.range;
+        if (zmax < n || zmin > f) return false;
+
+        range.min.z = depthSlice(std::max(zmin, n));
+        range.max.z = depthSlice(std::min(zmax, f));
+
+        if (zmin <= n)
+        {
+            // light volume crosses the near plane so can't be reliably projected
+            range.min.x = 0;
+            range.min.y = 0;
+            range.max.x = dimensions.x - 1;
+            range.max.y = dimensions.y - 1;
+            return true;
+        }
+
+        dbox ndc_bounds;
+        for (int i = 0; i < 8; ++i)
+        {
+            dvec3 corner(cl.eye_position.x + ((i & 1) ? cl.range : -cl.range),
+                         cl.eye_position.y + ((i & 2) ? cl.range : -cl.range),
+                         cl.eye_position.z + ((i & 4) ? cl.range : -cl.range));
+            ndc_bounds.add(projectionMatrix * corner);
+        }
+
+        if (ndc_bounds.max.x < -1.0 || ndc_bounds.min.x > 1.0 || ndc_bounds.max.y < -1.0 || ndc_bounds.min.y > 1.0) return false;
+
+        range.min.x = tile(ndc_bounds.min.x, dimensions.x);
+        range.max.x = tile(ndc_bounds.max.x, dimensions.x);
+        range.min.y = tile(ndc_bounds.min.y, dimensions.y);
+        range.max.y = tile(ndc_bounds.max.y, dimensions.y);
+        return true;
+    };
+
+    // first pass, count the number of lights in each cluster
+    _clusterCapacities.assign(numClusters, 0);
+
+    std::vector<std::pair<const ClusterLight*, ClusterRange>> lightRanges;
+    lightRanges.reserve(_clusterLights.size());
+    for (auto& cl : _clusterLights)
+    {
+        ClusterRange range;
+        if (!computeRange(cl, range)) continue;
+
+        lightRanges.emplace_back(&cl, range);
+        for (uint32_t z = range.min.z; z <= range.max.z; ++z)
+            for (uint32_t y = range.min.y; y <= range.max.y; ++y)
+                for (uint32_t x = range.min.x; x <= range.max.x; ++x)
+                    ++_clusterCapacities[x + dimensions.x * (y + dimensions.y * z)];
+    }
+
+    // assign offsets, clamping the number of indices to the space available
+    uint32_t numIndices = 0;
+    for (uint32_t c = 0; c < numClusters; ++c)
+    {
+        uint32_t capacity = std::min(_clusterCapacities[c], maxIndices - numIndices);
+        clusters[c * 2] = numIndices;
+        clusters[c * 2 + 1] = 0;
+        _clusterCapacities[c] = capacity;
+        numIndices += capacity;
+    }
+
+    // second pass, fill in the light indices of each cluster
+    for (auto& [cl, range] : lightRanges)
+    {
+        for (uint32_t z = range.min.z; z <= range.max.z; ++z)
+        {
+            for (uint32_t y = range.min.y; y <= range.max.y; ++y)
+            {
+                for (uint32_t x = range.min.x; x <= range.max.x; ++x)
+                {
+                    uint32_t c = x + dimensions.x * (y + dimensions.y * z);
+                    auto& count = clusters[c * 2 + 1];
+                    if (count < _clusterCapacities[c]) indices[clusters[c * 2] + count++] = cl->index;
+                }
+            }
+        }
+    }
+
+    header[0] = dimensions.x;
+    header[1] = dimensions.y;
+    header[2] = dimensions.z;
+    header[3] = numIndices;
+    header[4] = floatBits(n);
+    header[5] = floatBits(f);
+    header[6] = floatBits(sliceScale);
+    header[7] = floatBits(sliceBias);
+
+    // only the header, cluster table and used indices need transferring to the GPU
+    lightClusterData->dirty(0, (8 + 2 * numClusters + numIndices) * sizeof(uint32_t));
+}
+
 void ViewDependentState::bindDescriptorSets(CommandBuffer& commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, uint32_t firstSet)
 {
     auto vk = descriptorSet->vk(commandBuffer.deviceID);
@@ -10,9 +10,14 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/Value.h>
+#include <vsg/io/Logger.h>
 #include <vsg/text/TextLayout.h>
 #include <vsg/utils/SharedObjects.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace vsg;
 
 Font::Font()
@@ -46,7 +51,8 @@ void Font::write(Output& output) const
     output.write("descender", descender);
     output.write("height", height);
 
-    output.writeObject("charmap", charmap);
+    // the file format stores the dense charmap so expand the sparse pages when writing
+    output.writeObject("charmap", createDenseCharmap());
     output.writeObject("glyphMetrics", glyphMetrics);
     output.writeObject("atlas", atlas);
 
@@ -57,6 +63,67 @@ void Font::write(Output& output) const
     }
 }
 
+void Font::compactCharmap()
+{
+    if (!charmap) return;
+
+    uint32_t numPages = (static_cast<uint32_t>(charmap->size()) + charmapPageSize - 1) >> charmapPageShift;
+
+    // first pass find the pages that contain glyphs
+    std::vector<uint32_t> pageIndex(numPages, 0);
+    uint32_t numUsedPages = 0;
+    uint32_t lastUsedPage = 0;
+    for (uint32_t charcode = 0; charcode < charmap->size(); ++charcode)
+    {
+        uint32_t page = charcode >> charmapPageShift;
+        if (charmap->at(charcode) != 0 && pageIndex[page] == 0)
+        {
+            pageIndex[page] = ++numUsedPages;
+            lastUsedPage = page;
+        }
+    }
+
+    // second pass copy the used pages, trailing pages without glyphs are dropped from the index
+    charmapPageIndex = uintArray::create(numUsedPages > 0 ? lastUsedPage + 1 : 0);
+    charmapPages = uintArray::create(numUsedPages * charmapPageSize);
+    for (uint32_t page = 0; page < charmapPageIndex->size(); ++page)
+    {
+        uint32_t pageNumber = pageIndex[page];
+        charmapPageIndex->set(page, pageNumber);
+        if (pageNumber == 0) continue;
+
+        uint32_t begin = page << charmapPageShift;
+        uint32_t end = std::min(begin + charmapPageSize, static_cast<uint32_t>(charmap->size()));
+        uint32_t* dest = charmapPages->data() + ((pageNumber - 1) << charmapPageShift);
+        for (uint32_t charcode = begin; charcode < end; ++charcode)
+        {
+            *(dest++) = charmap->at(charcode);
+        }
+        for (uint32_t charcode = end; charcode < begin + charmapPageSize; ++charcode)
+        {
+            *(dest++) = 0;
+        }
+    }
+
+    charmap = {};
+}
+
+ref_ptr<uintArray> Font::createDenseCharmap() const
+{
+    if (charmap || !charmapPageIndex) return charmap;
+
+    auto dense = uintArray::create(static_cast<uint32_t>(charmapPageIndex->size()) << charmapPageShift, 0u);
+    for (uint32_t page = 0; page < charmapPageIndex->size(); ++page)
+    {
+        uint32_t pageNumber = charmapPageIndex->at(page);
+        if (pageNumber == 0) continue;
+
+        const uint32_t* src = charmapPages->data() + ((pageNumber - 1) << charmapPageShift);
+        std::copy(src, src + charmapPageSize, dense->data() + (page << charmapPageShift));
+    }
+    return dense;
+}
+
 void Font::createFontImages()
 {
     if (!atlasImageInfo)
@@ -89,8 +156,226 @@ void Font::createFontImages()
         uint32_t numVec4PerGlyph = static_cast<uint32_t>(sizeof(GlyphMetrics) / sizeof(vec4));
         uint32_t numGlyphs = static_cast<uint32_t>(glyphMetrics->valueCount());
 
-        auto glyphMetricsProxy = vec4Array2D::create(glyphMetrics, 0, stride, numVec4PerGlyph, numGlyphs,
-                                                     Data::Properties{VK_FORMAT_R32G32B32A32_SFLOAT});
+        Data::Properties properties{VK_FORMAT_R32G32B32A32_SFLOAT};
+        properties.dataVariance = glyphMetrics->properties.dataVariance;
+
+        auto glyphMetricsProxy = vec4Array2D::create(glyphMetrics, 0, stride, numVec4PerGlyph, numGlyphs, properties);
         glyphImageInfo = ImageInfo::create(glyphMetricSampler, glyphMetricsProxy);
     }
 }
+
+bool Font::reserveGlyphs(uint32_t numGlyphs, uint32_t atlasRows)
+{
+    auto previousAtlas = atlas.cast<ubyteArray2D>();
+    if (atlas && !previousAtlas)
+    {
+        warn("Font::reserveGlyphs(", numGlyphs, ", ", atlasRows, ") unsupported atlas type ", atlas->className(), ", only ubyteArray2D is supported.");
+        return false;
+    }
+
+    // extend the atlas with rows at the bottom, only the base mipmap level is retained as the mipmaps are regenerated from it
+    uint32_t width = previousAtlas ? previousAtlas->width() : 1024;
+    uint32_t previousHeight = previousAtlas ? previousAtlas->height() : 0;
+    uint32_t height = previousHeight + atlasRows;
+
+    auto properties = previousAtlas ? previousAtlas->properties : Data::Properties{VK_FORMAT_R8_UNORM};
+    properties.mipLevels = 1;
+    properties.dataVariance = DYNAMIC_DATA;
+
+    auto extendedAtlas = ubyteArray2D::create(width, height, properties);
+    size_t previousSize = static_cast<size_t>(width) * previousHeight;
+    if (previousAtlas) std::memcpy(extendedAtlas->dataPointer(), previousAtlas->dataPointer(), previousSize);
+    std::memset(static_cast<uint8_t*>(extendedAtlas->dataPointer()) + previousSize, 0, extendedAtlas->dataSize() - previousSize);
+    atlas = extendedAtlas;
+
+    // extend glyphMetrics, glyph index 0 is reserved for charcodes without a glyph
+    uint32_t previousNumGlyphs = glyphMetrics ? static_cast<uint32_t>(glyphMetrics->size()) : 1;
+    auto extendedGlyphMetrics = GlyphMetricsArray::create(previousNumGlyphs + numGlyphs);
+    for (uint32_t i = 0; i < extendedGlyphMetrics->size(); ++i)
+    {
+        auto& metrics = extendedGlyphMetrics->at(i);
+        if (glyphMetrics && i < glyphMetrics->size())
+        {
+            metrics = glyphMetrics->at(i);
+
+            // rescale the texture coordinates of the existing glyphs to the extended atlas
+            float scale = static_cast<float>(previousHeight) / static_cast<float>(height);
+            metrics.uvrect.y *= scale;
+            metrics.uvrect.w *= scale;
+        }
+        else
+        {
+            metrics = GlyphMetrics{};
+        }
+    }
+    extendedGlyphMetrics->properties.dataVariance = DYNAMIC_DATA;
+    glyphMetrics = extendedGlyphMetrics;
+
+    if (_nextGlyphIndex == 0)
+    {
+        _nextGlyphIndex = previousNumGlyphs;
+        _shelfX = 0;
+        _shelfY = previousHeight;
+        _shelfHeight = 0;
+    }
+
+    // the images are recreated to match the new atlas and glyphMetrics
+    atlasImageInfo = {};
+    glyphImageInfo = {};
+
+    return true;
+}
+
+namespace
+{
+    struct AddGlyphs : public ConstVisitor
+    {
+        Font& font;
+        uint32_t numAdded = 0;
+
+        explicit AddGlyphs(Font& in_font) :
+            font(in_font) {}
+
+        void apply(const stringValue& text) override
+        {
+            for (const auto& c : text.value()) character(uint32_t(c));
+        }
+        void apply(const wstringValue& text) override
+        {
+            for (const auto& c : text.value()) character(uint32_t(c));
+        }
+        void apply(const ubyteArray& text) override
+        {
+            for (const auto& c : text) character(c);
+        }
+        void apply(const ushortArray& text) override
+        {
+            for (const auto& c : text) character(c);
+        }
+        void apply(const uintArray& text) override
+        {
+            for (const auto& c : text) character(c);
+        }
+
+        void character(uint32_t charcode)
+        {
+            if (charcode == '\n' || font.glyphIndexForCharcode(charcode) != 0) return;
+            if (font.addGlyph(charcode) != 0) ++numAdded;
+        }
+    };
+} // namespace
+
+uint32_t Font::addGlyphs(const Data& text)
+{
+    if (!glyphSource) return 0;
+
+    AddGlyphs addGlyphs(*this);
+    text.accept(addGlyphs);
+    return addGlyphs.numAdded;
+}
+
+uint32_t Font::addGlyph(uint32_t charcode)
+{
+    if (auto glyphIndex = glyphIndexForCharcode(charcode)) return glyphIndex;
+    if (!glyphSource || _unavailableCharcodes.count(charcode) != 0) return 0;
+
+    auto atlasImage = atlas.cast<ubyteArray2D>();
+    if (!atlasImage || !glyphMetrics || _nextGlyphIndex == 0 || _nextGlyphIndex >= glyphMetrics->size())
+    {
+        warn("Font::addGlyph(", charcode, ") no glyphs reserved, call Font::reserveGlyphs(..) before adding glyphs.");
+        _unavailableCharcodes.insert(charcode);
+        return 0;
+    }
+
+    GlyphMetrics metrics{};
+    ref_ptr<ubyteArray2D> image;
+    if (!glyphSource->createGlyph(charcode, metrics, image))
+    {
+        _unavailableCharcodes.insert(charcode);
+        return 0;
+    }
+
+    uint32_t width = image ? image->width() : 0;
+    uint32_t height = image ? image->height() : 0;
+
+    // pack the glyphs in rows, leaving a texel between glyphs so that filtering doesn't bleed between them
+    if (_shelfX + width > atlasImage->width())
+    {
+        _shelfX = 0;
+        _shelfY += _shelfHeight;
+        _shelfHeight = 0;
+    }
+
+    if (width > atlasImage->width() || _shelfY + height > atlasImage->height())
+    {
+        warn("Font::addGlyph(", charcode, ") insufficient atlas space reserved for glyph.");
+        _unavailableCharcodes.insert(charcode);
+        return 0;
+    }
+
+    for (uint32_t row = 0; row < height; ++row)
+    {
+        std::memcpy(&atlasImage->at(_shelfX, _shelfY + row), &image->at(0, row), width);
+    }
+    atlasImage->dirty();
+
+    // the glyph's first row is its top, so the bottom of the glyph has the larger v coordinate
+    float atlasWidth = static_cast<float>(atlasImage->width());
+    float atlasHeight = static_cast<float>(atlasImage->height());
+    metrics.uvrect.set(static_cast<float>(_shelfX) / atlasWidth, static_cast<float>(_shelfY + height) / atlasHeight,
+                       static_cast<float>(_shelfX + width) / atlasWidth, static_cast<float>(_shelfY) / atlasHeight);
+
+    _shelfX += width + 1;
+    _shelfHeight = std::max(_shelfHeight, height + 1);
+
+    uint32_t glyphIndex = _nextGlyphIndex++;
+    glyphMetrics->at(glyphIndex) = metrics;
+    glyphMetrics->dirty();
+
+    // the glyphMetrics are uploaded through a proxy image so mark it modified too
+    if (glyphImageInfo && glyphImageInfo->imageView && glyphImageInfo->imageView->image && glyphImageInfo->imageView->image->data)
+    {
+        glyphImageInfo->imageView->image->data->dirty();
+    }
+
+    _assignGlyphIndex(charcode, glyphIndex);
+
+    return glyphIndex;
+}
+
+void Font::_assignGlyphIndex(uint32_t charcode, uint32_t glyphIndex)
+{
+    if (charmap)
+    {
+        if (charcode >= charmap->size())
+        {
+            auto extendedCharmap = uintArray::create(charcode + 1, 0u);
+            std::copy(charmap->begin(), charmap->end(), extendedCharmap->begin());
+            charmap = extendedCharmap;
+        }
+        charmap->set(charcode, glyphIndex);
+        return;
+    }
+
+    uint32_t page = charcode >> charmapPageShift;
+    if (!charmapPageIndex || page >= charmapPageIndex->size())
+    {
+        auto extendedPageIndex = uintArray::create(page + 1, 0u);
+        if (charmapPageIndex) std::copy(charmapPageIndex->begin(), charmapPageIndex->end(), extendedPageIndex->begin());
+        charmapPageIndex = extendedPageIndex;
+    }
+
+    uint32_t pageNumber = charmapPageIndex->at(page);
+    if (pageNumber == 0)
+    {
+        uint32_t numPages = charmapPages ? static_cast<uint32_t>(charmapPages->size() >> charmapPageShift) : 0;
+        auto extendedPages = uintArray::create((numPages + 1) << charmapPageShift, 0u);
+        if (charmapPages) std::copy(charmapPages->begin(), charmapPages->end(), extendedPages->begin());
+        charmapPages = extendedPages;
+
+        pageNumber = numPages + 1;
+        charmapPageIndex->set(page, pageNumber);
+    }
+
+    charmapPages->set(((pageNumber - 1) << charmapPageShift) | (charcode & (charmapPageSize - 1)), glyphIndex);
+}
@@ -63,6 +63,9 @@ void Text::setup(uint32_t minimumAllocation, ref_ptr<const Options> options)
     if (!layout) layout = StandardLayout::create();
     if (!technique) technique = CpuLayoutTechnique::create();
 
+    // rasterise any glyphs the text requires that the font doesn't yet have
+    if (font && font->glyphSource && text) font->addGlyphs(*text);
+
     technique->setup(this, minimumAllocation, options);
 }
 
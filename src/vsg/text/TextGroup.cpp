@@ -74,5 +74,14 @@ void TextGroup::setup(uint32_t minimumAllocation, ref_ptr<const Options> options
 
     if (!technique) technique = CpuLayoutTechnique::create();
 
+    // rasterise any glyphs the texts require that the font doesn't yet have
+    if (font && font->glyphSource)
+    {
+        for (auto& child : children)
+        {
+            if (child->text) font->addGlyphs(*child->text);
+        }
+    }
+
     technique->setup(this, minimumAllocation, options);
 }
@@ -16,16 +16,298 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/utils/Profiler.h>
 #include <vsg/vk/CommandBuffer.h>
 
+#include <algorithm>
+#include <iomanip>
+
 using namespace vsg;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // ProfileLog
 //
+namespace
+{
+    uint64_t nextLogID()
+    {
+        static std::atomic_uint64_t s_logID = 1;
+        return s_logID.fetch_add(1);
+    }
+} // namespace
+
 ProfileLog::ProfileLog(size_t size) :
     // TODO make user definable
-    entries(size)
+    entries(size),
+    _logID(nextLogID())
+{
+}
+
+ProfileLog::ThreadLog& ProfileLog::_threadLog()
+{
+    // cache the calling thread's ThreadLog so the lookup only takes the mutex the first time a thread enters this ProfileLog
+    struct Cache
+    {
+        uint64_t logID = 0;
+        ThreadLog* threadLog = nullptr;
+    };
+    thread_local Cache t_cache;
+    if (t_cache.logID == _logID) return *t_cache.threadLog;
+
+    std::scoped_lock<std::mutex> lock(_threadLogsMutex);
+
+    auto id = std::this_thread::get_id();
+    ThreadLog* threadLog = nullptr;
+    for (auto& tl : _threadLogs)
+    {
+        if (tl->thread_id == id) threadLog = tl.get();
+    }
+
+    if (!threadLog)
+    {
+        auto tl = std::make_unique<ThreadLog>();
+        tl->thread_id = id;
+        tl->threadIndex = _threadLogs.size();
+        tl->entries.resize(entries.size());
+        tl->sharedReferences.resize(entries.size());
+        threadLog = tl.get();
+        _threadLogs.push_back(std::move(tl));
+    }
+
+    t_cache.logID = _logID;
+    t_cache.threadLog = threadLog;
+    return *threadLog;
+}
+
+ProfileLog::ThreadLog* ProfileLog::_threadLog(uint64_t reference)
+{
+    uint64_t threadIndex = (reference >> threadReferenceShift) - 1;
+
+    std::scoped_lock<std::mutex> lock(_threadLogsMutex);
+    return (threadIndex < _threadLogs.size()) ? _threadLogs[threadIndex].get() : nullptr;
+}
+
+ProfileLog::Entry& ProfileLog::enter(uint64_t& reference, Type type, const SourceLocation* sourceLocation, const Object* object)
+{
+    auto& threadLog = _threadLog();
+
+    // discard the entry if the ring doesn't have space for it and the leave entries of all the open spans, so unmerged entries are never overwritten
+    if ((threadLog.next - threadLog.merged.load(std::memory_order_acquire)) + threadLog.depth + 2 > threadLog.entries.size())
+    {
+        reference = 0;
+        return threadLog.discarded;
+    }
+
+    ++threadLog.depth;
+    uint64_t local = threadLog.next++;
+    reference = ((threadLog.threadIndex + 1) << threadReferenceShift) | local;
+
+    Entry& enter_entry = threadLog.entries[local % threadLog.entries.size()];
+    enter_entry.enter = true;
+    enter_entry.type = type;
+    enter_entry.reference = 0;
+    enter_entry.cpuTime = clock::now();
+    enter_entry.gpuTime = 0;
+    enter_entry.sourceLocation = sourceLocation;
+    enter_entry.object = object;
+    enter_entry.thread_id = threadLog.thread_id;
+
+    // publish entry to mergeThreadLogs()
+    threadLog.written.store(threadLog.next, std::memory_order_release);
+    return enter_entry;
+}
+
+ProfileLog::Entry& ProfileLog::leave(uint64_t& reference, Type type, const SourceLocation* sourceLocation, const Object* object)
+{
+    auto& threadLog = _threadLog();
+
+    // discard leave entries of discarded enter entries, enter and leave are expected on the same thread as they are by the scoped instrumentation helpers
+    if ((reference >> threadReferenceShift) != (threadLog.threadIndex + 1))
+    {
+        reference = 0;
+        return threadLog.discarded;
+    }
+
+    --threadLog.depth;
+    uint64_t local = threadLog.next++;
+    uint64_t new_reference = ((threadLog.threadIndex + 1) << threadReferenceShift) | local;
+
+    // the enter entry may already have been merged, and its slot reused, so the link from the enter entry to this leave entry is assigned by mergeThreadLogs()
+
+    Entry& leave_entry = threadLog.entries[local % threadLog.entries.size()];
+    leave_entry.cpuTime = clock::now();
+    leave_entry.gpuTime = 0;
+    leave_entry.enter = false;
+    leave_entry.type = type;
+    leave_entry.reference = reference;
+    leave_entry.sourceLocation = sourceLocation;
+    leave_entry.object = object;
+    leave_entry.thread_id = threadLog.thread_id;
+    reference = new_reference;
+
+    // publish entry to mergeThreadLogs()
+    threadLog.written.store(threadLog.next, std::memory_order_release);
+    return leave_entry;
+}
+
+ProfileLog::Entry& ProfileLog::entry(uint64_t reference)
+{
+    if ((reference >> threadReferenceShift) != 0)
+    {
+        if (auto threadLog = _threadLog(reference))
+        {
+            uint64_t local = reference & localReferenceMask;
+            if (local >= threadLog->merged.load()) return threadLog->entries[local % threadLog->entries.size()];
+            reference = threadLog->sharedReferences[local % threadLog->sharedReferences.size()];
+        }
+    }
+    return entries[reference % entries.size()];
+}
+
+uint64_t ProfileLog::sharedReference(uint64_t reference)
+{
+    if ((reference >> threadReferenceShift) == 0) return reference;
+
+    auto threadLog = _threadLog(reference);
+    uint64_t local = reference & localReferenceMask;
+    if (!threadLog || local >= threadLog->merged.load()) return reference;
+
+    return threadLog->sharedReferences[local % threadLog->sharedReferences.size()];
+}
+
+void ProfileLog::mergeThreadLogs()
+{
+    // only one thread may merge at a time as the merge updates the ThreadLog's merged positions and open spans
+    std::scoped_lock<std::mutex> mergeLock(_mergeMutex);
+
+    struct Block
+    {
+        ThreadLog* threadLog;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    std::vector<Block> blocks;
+    {
+        std::scoped_lock<std::mutex> lock(_threadLogsMutex);
+        for (auto& tl : _threadLogs)
+        {
+            uint64_t written = tl->written.load(std::memory_order_acquire);
+            uint64_t merged = tl->merged.load(std::memory_order_relaxed);
+            if (written > merged) blocks.push_back(Block{tl.get(), merged, written});
+        }
+    }
+
+    if (blocks.empty()) return;
+
+    uint64_t firstShared = index.load();
+
+    // merge the blocks in time order, each block is already in time order
+    for (;;)
+    {
+        Block* next = nullptr;
+        for (auto& block : blocks)
+        {
+            if (block.begin == block.end) continue;
+            auto& candidate = block.threadLog->entries[block.begin % block.threadLog->entries.size()];
+            if (!next || candidate.cpuTime < next->threadLog->entries[next->begin % next->threadLog->entries.size()].cpuTime) next = &block;
+        }
+        if (!next) break;
+
+        auto& threadLog = *(next->threadLog);
+        uint64_t shared = index.fetch_add(1);
+        auto& merged_entry = entries[shared % entries.size()];
+        merged_entry = threadLog.entries[next->begin % threadLog.entries.size()];
+        threadLog.sharedReferences[next->begin % threadLog.sharedReferences.size()] = shared;
+        ++(next->begin);
+
+        // spans are nested on each thread, so the leave entry matches the most recent open enter entry,
+        // which may have been merged by an earlier call
+        if (merged_entry.enter)
+        {
+            merged_entry.reference = 0;
+            threadLog.openSpans.push_back(shared);
+        }
+        else if (!threadLog.openSpans.empty())
+        {
+            uint64_t enterShared = threadLog.openSpans.back();
+            threadLog.openSpans.pop_back();
+
+            merged_entry.reference = enterShared;
+            if (shared - enterShared < entries.size()) entries[enterShared % entries.size()].reference = shared;
+        }
+    }
+
+    // release the merged entries back to the owning threads
+    for (auto& block : blocks) block.threadLog->merged.store(block.end, std::memory_order_release);
+
+    // update the statistics with the spans completed by this merge
+    uint64_t lastShared = index.load();
+    for (uint64_t i = firstShared; i < lastShared; ++i)
+    {
+        auto& leave_entry = entries[i % entries.size()];
+        if (leave_entry.enter || !leave_entry.sourceLocation || i - leave_entry.reference >= entries.size()) continue;
+
+        auto& enter_entry = entries[leave_entry.reference % entries.size()];
+        if (enter_entry.enter && enter_entry.reference == i)
+        {
+            _addDuration(enter_entry.sourceLocation, std::chrono::duration<double, std::chrono::milliseconds::period>(leave_entry.cpuTime - enter_entry.cpuTime).count());
+        }
+    }
+}
+
+void ProfileLog::_addDuration(const SourceLocation* sourceLocation, double duration)
 {
+    std::scoped_lock<std::mutex> lock(_statisticsMutex);
+
+    auto& durations = _durations[sourceLocation];
+    if (durations.values.size() != statisticsWindowSize) durations.values.resize(statisticsWindowSize);
+    if (durations.values.empty()) return;
+
+    durations.values[durations.count % durations.values.size()] = duration;
+    ++durations.count;
+}
+
+ProfileLog::Statistics ProfileLog::statistics(const SourceLocation* sourceLocation) const
+{
+    std::vector<double> values;
+    Statistics stats;
+    {
+        std::scoped_lock<std::mutex> lock(_statisticsMutex);
+        auto itr = _durations.find(sourceLocation);
+        if (itr == _durations.end() || itr->second.count == 0) return stats;
+
+        stats.count = itr->second.count;
+        auto numValues = std::min(static_cast<size_t>(itr->second.count), itr->second.values.size());
+        values.assign(itr->second.values.begin(), itr->second.values.begin() + numValues);
+    }
+
+    std::sort(values.begin(), values.end());
+
+    auto percentile = [&values](double p) {
+        return values[std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())))];
+    };
+
+    double total = 0.0;
+    for (auto value : values) total += value;
+
+    stats.mean = total / static_cast<double>(values.size());
+    stats.p50 = percentile(0.5);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = values.back();
+    return stats;
+}
+
+std::map<const SourceLocation*, ProfileLog::Statistics> ProfileLog::statistics() const
+{
+    std::vector<const SourceLocation*> sourceLocations;
+    {
+        std::scoped_lock<std::mutex> lock(_statisticsMutex);
+        for (auto& [sourceLocation, durations] : _durations) sourceLocations.push_back(sourceLocation);
+    }
+
+    std::map<const SourceLocation*, Statistics> result;
+    for (auto sourceLocation : sourceLocations) result[sourceLocation] = statistics(sourceLocation);
+    return result;
 }
 
 void ProfileLog::read(Input& input)
@@ -127,6 +409,110 @@ uint64_t ProfileLog::report(std::ostream& out, uint64_t reference)
     return endReference + 1;
 }
 
+void ProfileLog::writeTraceEvents(std::ostream& out)
+{
+    static const char* typeNames[] = {
+        "NO_TYPE",
+        "FRAME",
+        "CPU",
+        "COMMAND_BUFFER",
+        "GPU"};
+
+    auto escape = [](const char* str) {
+        std::string result;
+        for (; str && *str; ++str)
+        {
+            if (*str == '"' || *str == '\\') result.push_back('\\');
+            result.push_back(*str);
+        }
+        return result;
+    };
+
+    // Chrome trace thread ids are the thread indices of the ThreadLogs
+    std::map<std::thread::id, uint64_t> threadIDs;
+    {
+        std::scoped_lock<std::mutex> lock(_threadLogsMutex);
+        for (auto& tl : _threadLogs) threadIDs[tl->thread_id] = tl->threadIndex + 1;
+    }
+
+    auto flags = out.flags();
+    auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+        if (!first) out << ",\n";
+        first = false;
+        return out;
+    };
+
+    out << "{\"traceEvents\":[\n";
+    separator() << R"({"ph":"M","pid":1,"name":"process_name","args":{"name":"CPU"}})";
+    separator() << R"({"ph":"M","pid":2,"name":"process_name","args":{"name":"GPU"}})";
+    for (auto& [id, tid] : threadIDs)
+    {
+        auto itr = threadNames.find(id);
+        std::string name = (itr != threadNames.end()) ? itr->second : make_string("thread ", tid);
+        separator() << R"({"ph":"M","pid":1,"tid":)" << tid << R"(,"name":"thread_name","args":{"name":")" << escape(name.c_str()) << R"("}})";
+    }
+
+    uint64_t endReference = index.load();
+    uint64_t startReference = (endReference > entries.size()) ? (endReference - entries.size()) : 0;
+    if (startReference < endReference)
+    {
+        auto startTime = entries[startReference % entries.size()].cpuTime;
+        auto microseconds = [&startTime](const vsg::time_point& time) {
+            return std::chrono::duration<double, std::chrono::microseconds::period>(time - startTime).count();
+        };
+
+        // GPU timestamps are in the device's time domain, so align the first GPU timestamp with the cpu time of its entry
+        bool gpuAligned = false;
+        uint64_t gpuBase = 0;
+        double gpuBaseTime = 0.0;
+        double timestampScaleToMicroseconds = timestampScaleToMilliseconds * 1000.0;
+
+        for (uint64_t i = startReference; i < endReference; ++i)
+        {
+            auto& enter_entry = entries[i % entries.size()];
+            if (!enter_entry.enter || enter_entry.reference <= i || enter_entry.reference >= endReference) continue;
+
+            auto& leave_entry = entries[enter_entry.reference % entries.size()];
+            auto sl = enter_entry.sourceLocation;
+            const char* name = (sl && sl->name) ? sl->name : (sl ? sl->function : typeNames[enter_entry.type]);
+            auto tid = threadIDs[enter_entry.thread_id];
+            auto ts = microseconds(enter_entry.cpuTime);
+
+            if (enter_entry.type == FRAME)
+            {
+                separator() << R"({"ph":"i","s":"g","pid":1,"tid":)" << tid << R"(,"name":"Frame","ts":)" << ts << "}";
+            }
+
+            separator() << R"({"ph":"X","pid":1,"tid":)" << tid << R"(,"cat":")" << typeNames[enter_entry.type] << R"(","name":")" << escape(name) << R"(","ts":)" << ts << R"(,"dur":)" << (microseconds(leave_entry.cpuTime) - ts);
+            if (sl) out << R"(,"args":{"function":")" << escape(sl->function) << R"(","file":")" << escape(sl->file) << R"(","line":)" << sl->line << "}";
+            out << "}";
+
+            if (enter_entry.gpuTime != 0 && leave_entry.gpuTime >= enter_entry.gpuTime)
+            {
+                if (!gpuAligned)
+                {
+                    gpuBase = enter_entry.gpuTime;
+                    gpuBaseTime = ts;
+                    gpuAligned = true;
+                }
+
+                double gpu_ts = gpuBaseTime + static_cast<double>(static_cast<int64_t>(enter_entry.gpuTime - gpuBase)) * timestampScaleToMicroseconds;
+                double gpu_dur = static_cast<double>(leave_entry.gpuTime - enter_entry.gpuTime) * timestampScaleToMicroseconds;
+                separator() << R"({"ph":"X","pid":2,"tid":)" << tid << R"(,"cat":")" << typeNames[enter_entry.type] << R"(","name":")" << escape(name) << R"(","ts":)" << gpu_ts << R"(,"dur":)" << gpu_dur << "}";
+            }
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // GPUStatsCollection
@@ -168,6 +554,9 @@ VkResult Profiler::getGpuResults(FrameStatsCollection& frameStats) const
             {
                 for (uint32_t i = 0; i < count; ++i)
                 {
+                    // entries discarded by a full ProfileLog have a reference of 0
+                    if (gpuStats->references[i] == 0) continue;
+
                     auto& gpu_entry = log->entry(gpuStats->references[i]);
                     gpu_entry.gpuTime = gpuStats->timestamps[i];
                 }
@@ -190,9 +579,7 @@ void Profiler::setThreadName(const std::string& name) const
 
 void Profiler::enterFrame(const SourceLocation* sl, uint64_t& reference, FrameStamp& frameStamp) const
 {
-    auto& entry = log->enter(reference, ProfileLog::FRAME);
-    entry.sourceLocation = sl;
-    entry.object = &frameStamp;
+    log->enter(reference, ProfileLog::FRAME, sl, &frameStamp);
 
     getGpuResults(perFrameGPUStats[frameIndex]);
 }
@@ -200,12 +587,21 @@ void Profiler::enterFrame(const SourceLocation* sl, uint64_t& reference, FrameSt
 void Profiler::leaveFrame(const SourceLocation* sl, uint64_t& reference, FrameStamp& frameStamp) const
 {
     uint64_t startReference = reference;
-    auto& entry = log->leave(reference, ProfileLog::FRAME);
-    entry.sourceLocation = sl;
-    entry.object = &frameStamp;
-    uint64_t endReference = reference;
+    log->leave(reference, ProfileLog::FRAME, sl, &frameStamp);
+
+    // frame entries discarded by a full ProfileLog have a reference of 0
+    bool recorded = startReference != 0;
 
-    if (endReference >= static_cast<uint64_t>(log->entries.size()))
+    // merge the entries recorded by all threads during the frame into the shared entries
+    log->mergeThreadLogs();
+
+    startReference = log->sharedReference(startReference);
+    uint64_t endReference = log->sharedReference(reference);
+
+    // thread references that are still unmerged have the thread index in the upper bits so can't be compared with shared entry positions
+    bool merged = (startReference >> ProfileLog::threadReferenceShift) == 0 && (endReference >> ProfileLog::threadReferenceShift) == 0;
+
+    if (recorded && merged && endReference >= static_cast<uint64_t>(log->entries.size()))
     {
         uint64_t safeReference = endReference - static_cast<uint64_t>(log->entries.size());
         size_t i = 0;
@@ -222,7 +618,7 @@ void Profiler::leaveFrame(const SourceLocation* sl, uint64_t& reference, FrameSt
         }
     }
 
-    log->frameIndices.push_back(startReference);
+    if (recorded && merged) log->frameIndices.push_back(startReference);
 
     // advance the frame index to the next frame position in the perFrameGPUStats container
     ++frameIndex;
@@ -233,9 +629,7 @@ void Profiler::enter(const SourceLocation* sl, uint64_t& reference, const Object
 {
     if (settings->cpu_instrumentation_level >= sl->level)
     {
-        auto& entry = log->enter(reference, ProfileLog::CPU);
-        entry.sourceLocation = sl;
-        entry.object = object;
+        log->enter(reference, ProfileLog::CPU, sl, object);
     }
 }
 
@@ -243,9 +637,7 @@ void Profiler::leave(const SourceLocation* sl, uint64_t& reference, const Object
 {
     if (settings->cpu_instrumentation_level >= sl->level)
     {
-        auto& entry = log->leave(reference, ProfileLog::CPU);
-        entry.sourceLocation = sl;
-        entry.object = object;
+        log->leave(reference, ProfileLog::CPU, sl, object);
     }
 }
 
@@ -282,9 +674,7 @@ void Profiler::enterCommandBuffer(const SourceLocation* sl, uint64_t& reference,
             }
         }
 
-        auto& entry = log->enter(reference, ProfileLog::COMMAND_BUFFER);
-        entry.sourceLocation = sl;
-        entry.object = &commandBuffer;
+        log->enter(reference, ProfileLog::COMMAND_BUFFER, sl, &commandBuffer);
 
         if (gpuStats)
         {
@@ -300,9 +690,7 @@ void Profiler::leaveCommandBuffer(const SourceLocation* sl, uint64_t& reference,
 {
     if (settings->gpu_instrumentation_level >= sl->level)
     {
-        auto& entry = log->leave(reference, ProfileLog::COMMAND_BUFFER);
-        entry.sourceLocation = sl;
-        entry.object = &commandBuffer;
+        log->leave(reference, ProfileLog::COMMAND_BUFFER, sl, &commandBuffer);
 
         if (commandBuffer.gpuStats) commandBuffer.gpuStats->writeGpuTimestamp(commandBuffer, reference, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
     }
@@ -312,9 +700,7 @@ void Profiler::enter(const SourceLocation* sl, uint64_t& reference, CommandBuffe
 {
     if (settings->gpu_instrumentation_level >= sl->level)
     {
-        auto& entry = log->enter(reference, ProfileLog::GPU);
-        entry.sourceLocation = sl;
-        entry.object = object;
+        log->enter(reference, ProfileLog::GPU, sl, object);
 
         if (commandBuffer.gpuStats) commandBuffer.gpuStats->writeGpuTimestamp(commandBuffer, reference, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
     }
@@ -324,9 +710,7 @@ void Profiler::leave(const SourceLocation* sl, uint64_t& reference, CommandBuffe
 {
     if (settings->gpu_instrumentation_level >= sl->level)
     {
-        auto& entry = log->leave(reference, ProfileLog::GPU);
-        entry.sourceLocation = sl;
-        entry.object = object;
+        log->leave(reference, ProfileLog::GPU, sl, object);
 
         if (commandBuffer.gpuStats) commandBuffer.gpuStats->writeGpuTimestamp(commandBuffer, reference, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
     }
@@ -338,4 +722,6 @@ void Profiler::finish() const
     {
         getGpuResults(gpuStats);
     }
+
+    log->mergeThreadLogs();
 }
@@ -18,6 +18,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/ComputePipeline.h>
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/utils/ShaderCompiler.h>
+#include <vsg/utils/SpirvCache.h>
 
 #if VSG_SUPPORTS_ShaderCompiler
 #    include <glslang/Public/ResourceLimits.h>
@@ -112,7 +113,8 @@ std::string debugFormatShaderSource(const std::string& source)
 
 ShaderCompiler::ShaderCompiler() :
     Inherit(),
-    defaults(ShaderCompileSettings::create())
+    defaults(ShaderCompileSettings::create()),
+    spirvCache(SpirvCache::instance())
 {
 }
 
@@ -130,6 +132,70 @@ bool ShaderCompiler::supported() const
 
 #if VSG_SUPPORTS_ShaderCompiler
 bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::string>& defines, ref_ptr<const Options> options)
+{
+    // compute the final source of each stage, and a key covering everything that affects the generated SPIR-V
+    std::vector<std::string> finalShaderSources;
+    SpirvCache::Hash hash;
+    hash.add(std::string(vsgGetVersionString()));
+    hash.add(VSG_SUPPORTS_ShaderOptimizer);
+
+    // glslang releases can change the generated SPIR-V so include its version in the key
+    auto glslangVersion = glslang::GetVersion();
+    hash.add(glslangVersion.major);
+    hash.add(glslangVersion.minor);
+    hash.add(glslangVersion.patch);
+    hash.add(std::string(glslangVersion.flavor ? glslangVersion.flavor : ""));
+
+    for (auto& vsg_shader : shaders)
+    {
+        auto settings = vsg_shader->module->hints ? vsg_shader->module->hints : defaults;
+
+        std::string finalShaderSource = vsg::insertIncludes(vsg_shader->module->source, options);
+
+        std::vector<std::string> combinedDefines(defines);
+        for (auto& define : settings->defines) combinedDefines.push_back(define);
+        if (!combinedDefines.empty()) finalShaderSource = combineSourceAndDefines(finalShaderSource, combinedDefines);
+
+        vsg::debug("ShaderCompiler::compile() combinedDefines = ", combinedDefines);
+
+        hash.add(vsg_shader->stage);
+        hash.add(finalShaderSource);
+        hash.add(settings->vulkanVersion);
+        hash.add(settings->clientInputVersion);
+        hash.add(settings->language);
+        hash.add(settings->defaultVersion);
+        hash.add(settings->target);
+        hash.add(settings->forwardCompatible);
+        hash.add(settings->generateDebugInfo);
+        hash.add(settings->optimize);
+
+        finalShaderSources.push_back(std::move(finalShaderSource));
+    }
+
+    if (!spirvCache) return _compile(shaders, finalShaderSources);
+
+    Path cacheDirectory;
+    if (options && options->fileCache) cacheDirectory = options->fileCache / "spirv";
+
+    auto key = hash.key();
+    if (SpirvCache::Entry entry; spirvCache->acquire(key, entry, cacheDirectory) && entry.size() == shaders.size())
+    {
+        for (size_t i = 0; i < shaders.size(); ++i) shaders[i]->module->code = entry[i];
+        return true;
+    }
+
+    // release the pending key if compilation fails or throws so other threads waiting on it don't block indefinitely
+    PendingSpirv pending(spirvCache.get(), key);
+    if (!_compile(shaders, finalShaderSources)) return false;
+
+    SpirvCache::Entry entry;
+    for (auto& vsg_shader : shaders) entry.push_back(vsg_shader->module->code);
+    pending.add(entry, cacheDirectory);
+
+    return true;
+}
+
+bool ShaderCompiler::_compile(ShaderStages& shaders, const std::vector<std::string>& finalShaderSources)
 {
     // need to balance the inits.
     if (!_initialized)
@@ -199,8 +265,9 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
     StageShaderMap stageShaderMap;
     std::unique_ptr<glslang::TProgram> program(new glslang::TProgram);
 
-    for (auto& vsg_shader : shaders)
+    for (size_t shaderIndex = 0; shaderIndex < shaders.size(); ++shaderIndex)
     {
+        auto& vsg_shader = shaders[shaderIndex];
         EShLanguage envStage = EShLangCount;
 
         glslang::EShTargetLanguageVersion minTargetLanguageVersion = glslang::EShTargetSpv_1_0;
@@ -278,13 +345,7 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
         shader->setEnvClient(glslang::EShClientVulkan, targetClientVersion);
         shader->setEnvTarget(glslang::EShTargetSpv, targetLanguageVersion);
 
-        std::string finalShaderSource = vsg::insertIncludes(vsg_shader->module->source, options);
-
-        std::vector<std::string> combinedDefines(defines);
-        for (auto& define : settings->defines) combinedDefines.push_back(define);
-        if (!combinedDefines.empty()) finalShaderSource = combineSourceAndDefines(finalShaderSource, combinedDefines);
-
-        vsg::debug("ShaderCompiler::compile() combinedDefines = ", combinedDefines);
+        const std::string& finalShaderSource = finalShaderSources[shaderIndex];
 
         const char* str = finalShaderSource.c_str();
         shader->setStrings(&str, 1);
@@ -452,6 +452,16 @@ void ShaderSet::write(Output& output) const
     }
 }
 
+void vsg::addLightClustersBinding(ShaderSet& shaderSet)
+{
+    // the light clusters are placed in the same view descriptor set as the lightData
+    auto& lightDataBinding = shaderSet.getDescriptorBinding("lightData");
+    if (!lightDataBinding || shaderSet.getDescriptorBinding("lightClusters")) return;
+
+    uint32_t viewDescriptorSet = lightDataBinding.set;
+    shaderSet.addDescriptorBinding("lightClusters", "VSG_CLUSTERED_LIGHTS", viewDescriptorSet, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, uintArray::create(8, 0u));
+}
+
 ref_ptr<ShaderSet> vsg::createFlatShadedShaderSet(ref_ptr<const Options> options)
 {
     if (options)
@@ -1,10 +1,188 @@
 
 #include <vsg/io/Logger.h>
 #include <vsg/io/Options.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/Image.h>
 #include <vsg/utils/SharedObjects.h>
 
+#include <cstring>
+
 using namespace vsg;
 
+namespace vsg
+{
+    /// Output that accumulates a hash of the values written by Object::write(Output&) rather than writing them to a stream.
+    class SharedObjectsHashOutput : public Output
+    {
+    public:
+        explicit SharedObjectsHashOutput(const SharedObjects& in_sharedObjects) :
+            sharedObjects(in_sharedObjects) {}
+
+        const SharedObjects& sharedObjects;
+        std::unordered_map<const Object*, uint64_t> objectHashes;
+        uint64_t value = 0;
+        size_t numValues = 0;
+
+        /// set by hash(), false when the object's members couldn't be hashed so the hash only represents its type
+        bool structural = true;
+
+        void add(const void* ptr, size_t size)
+        {
+            ++numValues;
+
+            // process 8 bytes at a time with a multiply/xorshift mix
+            auto bytes = static_cast<const uint8_t*>(ptr);
+            for (; size >= 8; size -= 8, bytes += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, bytes, 8);
+                value = (value ^ word) * 0x9E3779B97F4A7C15ull;
+                value ^= value >> 29;
+            }
+
+            if (size > 0)
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, bytes, size);
+                value = (value ^ word ^ (static_cast<uint64_t>(size) << 56)) * 0x9E3779B97F4A7C15ull;
+                value ^= value >> 29;
+            }
+        }
+
+        template<typename T>
+        void add(size_t num, const T* ptr) { add(ptr, num * sizeof(T)); }
+
+        void add(const std::string& str)
+        {
+            uint64_t size = str.size();
+            add(&size, sizeof(size));
+            add(str.data(), str.size());
+        }
+
+        uint64_t hash(const Object* object)
+        {
+            if (!object) return 0;
+
+            if (auto itr = objectHashes.find(object); itr != objectHashes.end()) return itr->second;
+
+            uint64_t result = 0;
+            if (sharedObjects._getCachedHash(object, result))
+            {
+                // only objects held by hash have cached hashes
+                structural = true;
+                return result;
+            }
+
+            // placeholder to prevent infinite recursion on cyclic graphs
+            objectHashes[object] = 0;
+
+            uint64_t parentValue = value;
+            size_t parentNumValues = numValues;
+            value = 14695981039346656037ull;
+
+            add(std::string(object->className()));
+
+            if (auto data = object->cast<Data>())
+            {
+                // mirror Data::compare(), comparing properties and values but not the Auxiliary
+                add(&data->properties, sizeof(Data::Properties));
+                uint64_t dataSize = data->dataSize();
+                add(&dataSize, sizeof(dataSize));
+                if (dataSize > 0) add(data->dataPointer(), dataSize);
+                structural = true;
+            }
+            else if (auto image = object->cast<Image>())
+            {
+                // Image isn't serialized so mirror the members used by Image::compare()
+                write(image->data.get());
+                add(&image->flags, sizeof(image->flags));
+                add(&image->imageType, sizeof(image->imageType));
+                add(&image->format, sizeof(image->format));
+                add(&image->extent, sizeof(image->extent));
+                add(&image->mipLevels, sizeof(image->mipLevels));
+                add(&image->arrayLayers, sizeof(image->arrayLayers));
+                add(&image->samples, sizeof(image->samples));
+                add(&image->tiling, sizeof(image->tiling));
+                add(&image->usage, sizeof(image->usage));
+                add(&image->sharingMode, sizeof(image->sharingMode));
+                add(image->queueFamilyIndices.size(), image->queueFamilyIndices.data());
+                add(&image->initialLayout, sizeof(image->initialLayout));
+                structural = true;
+            }
+            else
+            {
+                numValues = 0;
+                object->write(*this);
+
+                // Object::write(Output&) writes a single userObjects count, so a type that serializes nothing
+                // more has no members to hash and would collide with every other instance of its type.
+                structural = numValues > 1;
+            }
+
+            // final avalanche so that the low bits used to select shards are well distributed
+            result = value;
+            result ^= result >> 33;
+            result *= 0xff51afd7ed558ccdull;
+            result ^= result >> 33;
+
+            value = parentValue;
+            numValues = parentNumValues;
+            objectHashes[object] = result;
+            return result;
+        }
+
+        void writePropertyName(const char*) override {}
+        void writeEndOfLine() override {}
+
+        void write(size_t num, const int8_t* ptr) override { add(num, ptr); }
+        void write(size_t num, const uint8_t* ptr) override { add(num, ptr); }
+        void write(size_t num, const int16_t* ptr) override { add(num, ptr); }
+        void write(size_t num, const uint16_t* ptr) override { add(num, ptr); }
+        void write(size_t num, const int32_t* ptr) override { add(num, ptr); }
+        void write(size_t num, const uint32_t* ptr) override { add(num, ptr); }
+        void write(size_t num, const int64_t* ptr) override { add(num, ptr); }
+        void write(size_t num, const uint64_t* ptr) override { add(num, ptr); }
+        void write(size_t num, const float* ptr) override { add(num, ptr); }
+        void write(size_t num, const double* ptr) override { add(num, ptr); }
+
+        void write(size_t num, const long double* ptr) override
+        {
+            // long double may contain uninitialized padding bytes so hash as double
+            for (; num > 0; --num, ++ptr)
+            {
+                double d = static_cast<double>(*ptr);
+                add(&d, sizeof(d));
+            }
+        }
+
+        void write(size_t num, const std::string* ptr) override
+        {
+            for (; num > 0; --num, ++ptr) add(*ptr);
+        }
+
+        void write(size_t num, const std::wstring* ptr) override
+        {
+            for (; num > 0; --num, ++ptr)
+            {
+                std::string str;
+                convert_utf(*ptr, str);
+                add(str);
+            }
+        }
+
+        void write(size_t num, const Path* ptr) override
+        {
+            for (; num > 0; --num, ++ptr) add(ptr->string());
+        }
+
+        void write(const Object* object) override
+        {
+            uint64_t objectHash = hash(object);
+            add(&objectHash, sizeof(objectHash));
+        }
+    };
+} // namespace vsg
+
 SharedObjects::SharedObjects() :
     suitableForSharing(SuitableForSharing::create())
 {
@@ -14,6 +192,80 @@ SharedObjects::~SharedObjects()
 {
 }
 
+uint64_t SharedObjects::hash(const Object* object) const
+{
+    uint64_t value = 0;
+    _hash(object, value);
+    return value;
+}
+
+bool SharedObjects::_hash(const Object* object, uint64_t& value) const
+{
+    SharedObjectsHashOutput output(*this);
+    value = output.hash(object);
+    return output.structural;
+}
+
+bool SharedObjects::_getCachedHash(const Object* object, uint64_t& value) const
+{
+    std::scoped_lock<std::mutex> lock(_hashCacheMutex);
+
+    auto itr = _hashCache.find(object);
+    if (itr == _hashCache.end()) return false;
+
+    // Data that has been modified since it was hashed needs rehashing
+    if (auto data = object->cast<Data>(); data && data->differentModifiedCount(itr->second.modifiedCount)) return false;
+
+    value = itr->second.hash;
+    return true;
+}
+
+ref_ptr<Object> SharedObjects::_findOrInsert(ref_ptr<Object> object, const std::type_index& id, bool insert)
+{
+    if (!object) return {};
+
+    uint64_t objectHash = 0;
+    if (!_hash(object.get(), objectHash))
+    {
+        // no structural hash for this type so fall back to an ordered set using Object::compare()
+        auto& shard = _shards[objectHash % numShards];
+
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        auto& objects = shard.orderedObjects[id];
+        if (auto itr = objects.find(object); itr != objects.end()) return *itr;
+
+        if (!insert) return {};
+
+        objects.insert(object);
+        return object;
+    }
+
+    auto& shard = _shards[objectHash % numShards];
+
+    std::scoped_lock<std::mutex> lock(shard.mutex);
+
+    auto& objects = shard.objects[id];
+    auto [first, last] = objects.equal_range(objectHash);
+    for (auto itr = first; itr != last; ++itr)
+    {
+        if (itr->second == object || itr->second->compare(*object) == 0) return itr->second;
+    }
+
+    if (!insert) return {};
+
+    objects.emplace(objectHash, object);
+
+    CachedHash cachedHash;
+    cachedHash.hash = objectHash;
+    if (auto data = object->cast<Data>()) data->getModifiedCount(cachedHash.modifiedCount);
+
+    std::scoped_lock<std::mutex> hashCacheLock(_hashCacheMutex);
+    _hashCache[object.get()] = cachedHash;
+
+    return object;
+}
+
 bool SharedObjects::suitable(const Path& filename) const
 {
     return excludedExtensions.count(vsg::lowerCaseFileExtension(filename)) == 0;
@@ -23,40 +275,26 @@ bool SharedObjects::contains(const Path& filename, ref_ptr<const Options> option
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
-    auto loadedObject_id = std::type_index(typeid(LoadedObject));
-    auto itr = _sharedObjects.find(loadedObject_id);
-    if (itr == _sharedObjects.end()) return false;
-
-    auto& loadedObjects = itr->second;
     auto key = LoadedObject::create(filename, options);
-    return loadedObjects.find(key) != loadedObjects.end();
+    return _loadedObjects.find(key) != _loadedObjects.end();
 }
 
 void SharedObjects::add(ref_ptr<Object> object, const Path& filename, ref_ptr<const Options> options)
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
-    auto loadedObject_id = std::type_index(typeid(LoadedObject));
-    auto& loadedObjects = _sharedObjects[loadedObject_id];
-
     auto key = LoadedObject::create(filename, options, object);
-    loadedObjects.insert(key);
+    _loadedObjects.insert(key);
 }
 
 bool SharedObjects::remove(const Path& filename, ref_ptr<const Options> options)
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
-    auto loadedObject_id = std::type_index(typeid(LoadedObject));
-    auto itr = _sharedObjects.find(loadedObject_id);
-    if (itr == _sharedObjects.end()) return false;
-
-    auto& loadedObjects = itr->second;
-
     auto key = LoadedObject::create(filename, options);
-    if (auto lo_itr = loadedObjects.find(key); lo_itr != loadedObjects.end())
+    if (auto lo_itr = _loadedObjects.find(key); lo_itr != _loadedObjects.end())
     {
-        loadedObjects.erase(lo_itr);
+        _loadedObjects.erase(lo_itr);
         return true;
     }
     else
@@ -69,20 +307,27 @@ void SharedObjects::clear()
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
     _defaults.clear();
-    _sharedObjects.clear();
+    _loadedObjects.clear();
+
+    for (auto& shard : _shards)
+    {
+        std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+        shard.objects.clear();
+        shard.orderedObjects.clear();
+    }
+
+    std::scoped_lock<std::mutex> hashCacheLock(_hashCacheMutex);
+    _hashCache.clear();
 }
 
 void SharedObjects::prune()
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
-    auto loadedObject_id = std::type_index(typeid(LoadedObject));
-
     // record observer pointers for each LoadedObject object so we can clear them to prevent local references keeping them from being pruned
-    auto& loadedObjects = _sharedObjects[loadedObject_id];
-    std::vector<observer_ptr<Object>> observedLoadedObjects(loadedObjects.size());
+    std::vector<observer_ptr<Object>> observedLoadedObjects(_loadedObjects.size());
     auto observedLoadedObject_itr = observedLoadedObjects.begin();
-    for (auto& object : loadedObjects)
+    for (auto& object : _loadedObjects)
     {
         auto& loadedObject = static_cast<LoadedObject&>(*object);
         *(observedLoadedObject_itr++) = loadedObject.object;
@@ -103,17 +348,36 @@ void SharedObjects::prune()
     do
     {
         prunedObjects = false;
-        for (auto itr = _sharedObjects.begin(); itr != _sharedObjects.end(); ++itr)
+        for (auto& shard : _shards)
         {
-            auto id = itr->first;
-            if (id != loadedObject_id)
+            std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+            for (auto& [id, objects] : shard.objects)
+            {
+                for (auto object_itr = objects.begin(); object_itr != objects.end();)
+                {
+                    if (object_itr->second->referenceCount() == 1)
+                    {
+                        // vsg::info("pruning ", object_itr->second);
+                        {
+                            std::scoped_lock<std::mutex> hashCacheLock(_hashCacheMutex);
+                            _hashCache.erase(object_itr->second.get());
+                        }
+                        object_itr = objects.erase(object_itr);
+                        prunedObjects = true;
+                    }
+                    else
+                    {
+                        ++object_itr;
+                    }
+                }
+            }
+
+            for (auto& [id, objects] : shard.orderedObjects)
             {
-                auto& objects = itr->second;
-                for (auto object_itr = itr->second.begin(); object_itr != itr->second.end();)
+                for (auto object_itr = objects.begin(); object_itr != objects.end();)
                 {
                     if ((*object_itr)->referenceCount() == 1)
                     {
-                        // vsg::info("pruning ", *object_itr);
                         object_itr = objects.erase(object_itr);
                         prunedObjects = true;
                     }
@@ -127,14 +391,14 @@ void SharedObjects::prune()
     } while (prunedObjects);
 
     observedLoadedObject_itr = observedLoadedObjects.begin();
-    for (auto object_itr = loadedObjects.begin(); object_itr != loadedObjects.end();)
+    for (auto object_itr = _loadedObjects.begin(); object_itr != _loadedObjects.end();)
     {
         auto& loadedObject = static_cast<LoadedObject&>(*(*object_itr));
         loadedObject.object = *(observedLoadedObject_itr++);
         if (!loadedObject.object)
         {
             // vsg::info("pruning loadedObject ", *object_itr);
-            object_itr = loadedObjects.erase(object_itr);
+            object_itr = _loadedObjects.erase(object_itr);
         }
         else
         {
@@ -168,22 +432,42 @@ void SharedObjects::report(vsg::LogOutput& output)
     output.out();
     output("}");
 
-    output("SharedObjects::_sharedObjects ", SharedObjects::_sharedObjects.size(), " {");
+    output("SharedObjects::_loadedObjects ", _loadedObjects.size(), " {");
+    output.in();
+    for (auto& object : _loadedObjects)
+    {
+        auto loadedObject = object.cast<LoadedObject>();
+        output("loadedObject = ", loadedObject, " ", object->referenceCount(), " ", loadedObject->filename);
+    }
+    output.out();
+    output("}");
+
+    // gather the objects of each type across the shards
+    std::map<std::type_index, std::vector<ref_ptr<Object>>> sharedObjects;
+    for (auto& shard : _shards)
+    {
+        std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+        for (auto& [type, objects] : shard.objects)
+        {
+            auto& typeObjects = sharedObjects[type];
+            for (auto& entry : objects) typeObjects.push_back(entry.second);
+        }
+        for (auto& [type, objects] : shard.orderedObjects)
+        {
+            auto& typeObjects = sharedObjects[type];
+            typeObjects.insert(typeObjects.end(), objects.begin(), objects.end());
+        }
+    }
+
+    output("SharedObjects::_shards ", sharedObjects.size(), " {");
     output.in();
-    for (auto& [type, objects] : _sharedObjects)
+    for (auto& [type, objects] : sharedObjects)
     {
         output(type.name(), ", objects = ", objects.size(), " {");
         output.in();
         for (auto& object : objects)
         {
-            if (auto loadedObject = object.cast<LoadedObject>())
-            {
-                output("loadedObject = ", loadedObject, " ", object->referenceCount(), " ", loadedObject->filename);
-            }
-            else
-            {
-                output("object = ", object, " ", object->referenceCount());
-            }
+            output("object = ", object, " ", object->referenceCount() - 1);
         }
         output.out();
         output("}");
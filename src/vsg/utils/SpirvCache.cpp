@@ -0,0 +1,220 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/FileSystem.h>
+#include <vsg/io/Logger.h>
+#include <vsg/utils/SpirvCache.h>
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace vsg;
+
+namespace
+{
+    const char s_fileIdentifier[8] = {'v', 's', 'g', 's', 'p', 'i', 'r', 'v'};
+
+    bool readEntry(const Path& filename, SpirvCache::Entry& entry)
+    {
+        std::ifstream fin(filename, std::ios::in | std::ios::binary);
+        if (!fin) return false;
+
+        fin.seekg(0, std::ios::end);
+        auto fileSize = fin.tellg();
+        fin.seekg(0, std::ios::beg);
+        if (fileSize < 0) return false;
+
+        // bound every count read from the file by the bytes remaining so a truncated or corrupt file can't trigger a huge allocation
+        uint64_t remaining = static_cast<uint64_t>(fileSize);
+
+        char identifier[8];
+        uint32_t numStages = 0;
+        fin.read(identifier, sizeof(identifier));
+        fin.read(reinterpret_cast<char*>(&numStages), sizeof(numStages));
+        if (!fin || std::memcmp(identifier, s_fileIdentifier, sizeof(identifier)) != 0) return false;
+
+        remaining -= sizeof(identifier) + sizeof(numStages);
+        if (static_cast<uint64_t>(numStages) * sizeof(uint32_t) > remaining) return false;
+
+        entry.resize(numStages);
+        for (auto& code : entry)
+        {
+            uint32_t size = 0;
+            fin.read(reinterpret_cast<char*>(&size), sizeof(size));
+            if (!fin) return false;
+
+            remaining -= sizeof(size);
+            uint64_t codeSize = static_cast<uint64_t>(size) * sizeof(uint32_t);
+            if (codeSize > remaining) return false;
+            remaining -= codeSize;
+
+            code.resize(size);
+            fin.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(size * sizeof(uint32_t)));
+        }
+
+        return fin.good();
+    }
+
+    void writeEntry(const Path& filename, const SpirvCache::Entry& entry)
+    {
+        if (auto path = filePath(filename)) makeDirectory(path);
+
+        std::ofstream fout(filename, std::ios::out | std::ios::binary);
+        if (!fout)
+        {
+            warn("SpirvCache : unable to write ", filename);
+            return;
+        }
+
+        uint32_t numStages = static_cast<uint32_t>(entry.size());
+        fout.write(s_fileIdentifier, sizeof(s_fileIdentifier));
+        fout.write(reinterpret_cast<const char*>(&numStages), sizeof(numStages));
+        for (const auto& code : entry)
+        {
+            uint32_t size = static_cast<uint32_t>(code.size());
+            fout.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            fout.write(reinterpret_cast<const char*>(code.data()), static_cast<std::streamsize>(size * sizeof(uint32_t)));
+        }
+    }
+} // namespace
+
+void SpirvCache::Hash::add(const void* ptr, size_t size)
+{
+    // FNV-1a for the first half of the key, a multiply/xorshift mix for the second
+    auto bytes = static_cast<const uint8_t*>(ptr);
+    for (size_t i = 0; i < size; ++i)
+    {
+        first = (first ^ bytes[i]) * 1099511628211ull;
+        second = (second ^ bytes[i]) * 0xBF58476D1CE4E5B9ull;
+        second ^= second >> 31;
+    }
+}
+
+void SpirvCache::Hash::add(const std::string& str)
+{
+    add(static_cast<uint64_t>(str.size()));
+    add(str.data(), str.size());
+}
+
+SpirvCache::SpirvCache()
+{
+}
+
+SpirvCache::~SpirvCache()
+{
+}
+
+ref_ptr<SpirvCache>& SpirvCache::instance()
+{
+    static ref_ptr<SpirvCache> s_spirvCache(new SpirvCache);
+    return s_spirvCache;
+}
+
+std::string SpirvCache::toString(const Key& key)
+{
+    std::ostringstream str;
+    str << std::hex << std::setfill('0') << std::setw(16) << key.first << std::setw(16) << key.second;
+    return str.str();
+}
+
+bool SpirvCache::acquire(const Key& key, Entry& entry, const Path& directory)
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        bool waited = false;
+        while (_pending.count(key) != 0)
+        {
+            // another thread is compiling the same shaders so wait for it to complete
+            if (!waited) ++_statistics.waits;
+            waited = true;
+            _cv.wait(lock);
+        }
+
+        if (auto itr = _entries.find(key); itr != _entries.end())
+        {
+            ++_statistics.memoryHits;
+            entry = itr->second;
+            return true;
+        }
+
+        _pending.insert(key);
+    }
+
+    if (directory)
+    {
+        if (Entry fileEntry; readEntry(directory / (toString(key) + ".spv"), fileEntry))
+        {
+            std::scoped_lock<std::mutex> lock(_mutex);
+            ++_statistics.fileHits;
+            _insert(key, fileEntry);
+            entry = std::move(fileEntry);
+            _pending.erase(key);
+            _cv.notify_all();
+            return true;
+        }
+    }
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    ++_statistics.misses;
+    return false;
+}
+
+void SpirvCache::add(const Key& key, const Entry& entry, const Path& directory)
+{
+    if (directory) writeEntry(directory / (toString(key) + ".spv"), entry);
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _insert(key, entry);
+    _pending.erase(key);
+    _cv.notify_all();
+}
+
+void SpirvCache::release(const Key& key)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _pending.erase(key);
+    _cv.notify_all();
+}
+
+void SpirvCache::clear()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _entries.clear();
+    _insertionOrder.clear();
+}
+
+void SpirvCache::_insert(const Key& key, const Entry& entry)
+{
+    if (auto itr = _entries.find(key); itr != _entries.end())
+    {
+        itr->second = entry;
+        return;
+    }
+
+    while (!_insertionOrder.empty() && _entries.size() >= maxMemoryEntries)
+    {
+        _entries.erase(_insertionOrder.front());
+        _insertionOrder.pop_front();
+    }
+
+    _entries[key] = entry;
+    _insertionOrder.push_back(key);
+}
+
+SpirvCache::Statistics SpirvCache::getStatistics() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _statistics;
+}
@@ -96,6 +96,8 @@ Context::Context(Device* in_device, const ResourceRequirements& in_resourceRequi
     //semaphore = vsg::Semaphore::create(device);
     scratchMemory = ScratchMemory::create(4096);
 
+    pipelineCache = device->pipelineCache;
+
     vsg::debug("Context::Context() ", this);
 
     deviceMemoryBufferPools = device->deviceMemoryBufferPools.ref_ptr();
@@ -149,6 +151,7 @@ Context::Context(const Context& context) :
     defaultPipelineStates(context.defaultPipelineStates),
     overridePipelineStates(context.overridePipelineStates),
     descriptorPools(context.descriptorPools),
+    pipelineCache(context.pipelineCache),
     graphicsQueue(context.graphicsQueue),
     commandPool(context.commandPool),
     deviceMemoryBufferPools(context.deviceMemoryBufferPools),
@@ -16,6 +16,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/DescriptorPools.h>
 #include <vsg/vk/Device.h>
 #include <vsg/vk/MemoryBufferPools.h>
+#include <vsg/vk/PipelineCache.h>
 
 #include <cstring>
 #include <set>
@@ -167,6 +168,9 @@ Device::Device(PhysicalDevice* physicalDevice, const QueueSettings& queueSetting
 
 Device::~Device()
 {
+    // the VkPipelineCache must be destroyed before the VkDevice, even if the PipelineCache is still referenced elsewhere
+    if (pipelineCache) pipelineCache->release();
+
     if (_device)
     {
         vkDestroyDevice(_device, _allocator);
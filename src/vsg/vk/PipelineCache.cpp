@@ -0,0 +1,210 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2025 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Exception.h>
+#include <vsg/io/FileSystem.h>
+#include <vsg/io/Logger.h>
+#include <vsg/vk/PipelineCache.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace vsg;
+
+namespace
+{
+    /// header written ahead of the VkPipelineCache data to identify the device and driver that the data is compatible with.
+    struct PipelineCacheFileHeader
+    {
+        char identifier[8] = {'v', 's', 'g', 'p', 'c', 'a', 'c', 'h'};
+        uint32_t headerVersion = 1;
+        uint32_t vendorID = 0;
+        uint32_t deviceID = 0;
+        uint32_t driverVersion = 0;
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+        uint64_t dataSize = 0;
+
+        explicit PipelineCacheFileHeader(const VkPhysicalDeviceProperties& properties) :
+            vendorID(properties.vendorID),
+            deviceID(properties.deviceID),
+            driverVersion(properties.driverVersion)
+        {
+            std::memcpy(pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+        }
+
+        bool compatible(const PipelineCacheFileHeader& rhs) const
+        {
+            return std::memcmp(identifier, rhs.identifier, sizeof(identifier)) == 0 &&
+                   headerVersion == rhs.headerVersion &&
+                   vendorID == rhs.vendorID &&
+                   deviceID == rhs.deviceID &&
+                   driverVersion == rhs.driverVersion &&
+                   std::memcmp(pipelineCacheUUID, rhs.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        }
+    };
+} // namespace
+
+PipelineCache::PipelineCache(Device* device, const Path& in_filename) :
+    filename(in_filename),
+    _pipelineCache(VK_NULL_HANDLE),
+    _device(device)
+{
+    std::vector<uint8_t> initialData;
+    if (filename) _read(initialData);
+
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.initialDataSize = initialData.size();
+    createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+    VkResult result = vkCreatePipelineCache(*device, &createInfo, device->getAllocationCallbacks(), &_pipelineCache);
+    if (result != VK_SUCCESS && !initialData.empty())
+    {
+        warn("PipelineCache::PipelineCache() contents of ", filename, " rejected by driver, starting with an empty cache.");
+
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        result = vkCreatePipelineCache(*device, &createInfo, device->getAllocationCallbacks(), &_pipelineCache);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        throw Exception{"Error: Failed to create VkPipelineCache.", result};
+    }
+}
+
+PipelineCache::~PipelineCache()
+{
+    release();
+}
+
+void PipelineCache::release()
+{
+    if (!_device) return;
+
+    if (filename) write(filename);
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    vkDestroyPipelineCache(*_device, _pipelineCache, _device->getAllocationCallbacks());
+    _pipelineCache = VK_NULL_HANDLE;
+    _device = nullptr;
+}
+
+std::vector<uint8_t> PipelineCache::getData() const
+{
+    std::vector<uint8_t> data;
+    if (!_device) return data;
+
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(*_device, _pipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) return data;
+
+    data.resize(dataSize);
+    if (vkGetPipelineCacheData(*_device, _pipelineCache, &dataSize, data.data()) != VK_SUCCESS)
+    {
+        data.clear();
+        return data;
+    }
+
+    data.resize(dataSize);
+    return data;
+}
+
+bool PipelineCache::_read(std::vector<uint8_t>& data) const
+{
+    std::ifstream fin(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!fin) return false;
+
+    auto fileSize = static_cast<uint64_t>(fin.tellg());
+    fin.seekg(0);
+
+    PipelineCacheFileHeader expected(_device->getPhysicalDevice()->getProperties());
+    PipelineCacheFileHeader header(_device->getPhysicalDevice()->getProperties());
+    fin.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!fin || !header.compatible(expected))
+    {
+        info("PipelineCache : ", filename, " was written for a different device or driver, ignoring it.");
+        return false;
+    }
+
+    // don't trust the header's dataSize beyond what the file contains
+    if (fileSize < sizeof(header) || header.dataSize > (fileSize - sizeof(header)))
+    {
+        warn("PipelineCache : ", filename, " is truncated or corrupt, ignoring it.");
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(header.dataSize));
+    fin.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!fin)
+    {
+        warn("PipelineCache : ", filename, " is truncated, ignoring it.");
+        data.clear();
+        return false;
+    }
+
+    debug("PipelineCache : read ", data.size(), " bytes from ", filename);
+    return true;
+}
+
+bool PipelineCache::write(const Path& in_filename) const
+{
+    if (!in_filename) return false;
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto data = getData();
+    if (data.empty()) return false;
+
+    if (auto path = filePath(in_filename)) makeDirectory(path);
+
+    // write to a temporary file alongside the destination and rename it over the destination once complete
+    Path tempFilename = in_filename;
+    tempFilename.concat(".tmp");
+
+    {
+        std::ofstream fout(tempFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!fout)
+        {
+            warn("PipelineCache::write() unable to open ", tempFilename);
+            return false;
+        }
+
+        PipelineCacheFileHeader header(_device->getPhysicalDevice()->getProperties());
+        header.dataSize = data.size();
+
+        fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        fout.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        fout.close();
+
+        if (!fout)
+        {
+            warn("PipelineCache::write() failed writing ", tempFilename);
+            std::remove(tempFilename.string().c_str());
+            return false;
+        }
+    }
+
+    if (!renameFile(tempFilename, in_filename))
+    {
+        warn("PipelineCache::write() unable to rename ", tempFilename, " to ", in_filename);
+        std::remove(tempFilename.string().c_str());
+        return false;
+    }
+
+    debug("PipelineCache::write() wrote ", data.size(), " bytes to ", in_filename);
+    return true;
+}